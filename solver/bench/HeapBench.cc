@@ -0,0 +1,168 @@
+/************************************************************************************[HeapBench.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+
+#include "solver/mtl/Heap.h"
+#include "solver/mtl/DaryHeap.h"
+#include "solver/mtl/Rnd.h"
+#include "solver/utils/Options.h"
+#include "solver/utils/System.h"
+#include "solver/core/SolverTypes.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Decision order microbenchmark -- replays the same VSIDS-like workload on 'Heap' (the binary heap
+// with an activity comparator) and 'DaryHeap' (the 4-ary heap with inline keys):
+//
+// Each round takes 'decisions' variables with 'removeMin', bumps 'bumps' variables (skewed towards
+// the low indices, like the variables of a busy part of the problem) with a growing increment, and
+// puts the taken variables back, as backtracking does. Both heaps see the same operations, the sum
+// of the keys they remove is printed to check that they agree.
+
+struct ActivityLt
+{
+    const VMap<double> &activity;
+    bool operator()(Var x, Var y) const { return activity[x] > activity[y]; }
+    ActivityLt(const VMap<double> &act) : activity(act) {}
+};
+
+struct ActivityKey
+{
+    const VMap<double> &activity;
+    double operator()(Var x) const { return activity[x]; }
+    ActivityKey(const VMap<double> &act) : activity(act) {}
+};
+
+struct Workload
+{
+    int vars;
+    int rounds;
+    int decisions;
+    vec<Var> bumped; // 'bumps' variables for each round.
+};
+
+// Scaling the keys is the only operation 'Heap' does not need (its comparator reads the activities):
+template <class H>
+static void scaleKeys(H &heap, double factor) { heap.scaleKeys(factor); }
+
+template <class K, class C>
+static void scaleKeys(Heap<K, C> &, double) {}
+
+template <class H>
+static double run(H &heap, VMap<double> &activity, const Workload &w, double &checksum)
+{
+    double seed = 91648253;
+    for (Var v = 0; v < w.vars; v++)
+    {
+        activity[v] = drand(seed) * 0.00001;
+        heap.insert(v);
+    }
+
+    double start_time = cpuTime();
+    double inc = 1;
+    int bumps = w.bumped.size() / w.rounds;
+    vec<Var> taken;
+    checksum = 0;
+    for (int r = 0; r < w.rounds; r++)
+    {
+        taken.clear();
+        for (int i = 0; i < w.decisions && !heap.empty(); i++)
+        {
+            Var v = heap.removeMin();
+            checksum += activity[v];
+            taken.push(v);
+        }
+
+        for (int i = r * bumps; i < (r + 1) * bumps; i++)
+        {
+            Var v = w.bumped[i];
+            if ((activity[v] += inc) > 1e100)
+            {
+                for (Var x = 0; x < w.vars; x++)
+                {
+                    activity[x] *= 1e-100;
+                }
+
+                scaleKeys(heap, 1e-100);
+                inc *= 1e-100;
+            }
+
+            if (heap.inHeap(v))
+            {
+                heap.decrease(v);
+            }
+        }
+
+        inc *= 1 / 0.95;
+        for (int i = 0; i < taken.size(); i++)
+        {
+            heap.insert(taken[i]);
+        }
+    }
+
+    return cpuTime() - start_time;
+}
+
+int main(int argc, char **argv)
+{
+    setUsageHelp("USAGE: %s [options]\n\n  Compares the decision order heaps on a VSIDS-like workload.\n");
+
+    IntOption opt_vars("BENCH", "vars", "Number of variables.", 200000, IntRange(1, INT32_MAX));
+    IntOption opt_rounds("BENCH", "rounds", "Number of rounds (conflicts).", 20000, IntRange(1, INT32_MAX));
+    IntOption opt_decisions("BENCH", "decisions", "Variables taken from the heap each round.", 50, IntRange(0, INT32_MAX));
+    IntOption opt_bumps("BENCH", "bumps", "Variables bumped each round.", 100, IntRange(0, INT32_MAX));
+
+    parseOptions(argc, argv, true);
+
+    Workload w;
+    w.vars = opt_vars;
+    w.rounds = opt_rounds;
+    w.decisions = opt_decisions;
+
+    double seed = 1234567;
+    for (int i = 0; i < w.rounds * opt_bumps; i++)
+    {
+        double x = drand(seed);
+        w.bumped.push((Var)(x * x * w.vars));
+    }
+
+    VMap<double> activity;
+    activity.reserve(w.vars - 1, 0);
+
+    double binary_checksum, dary_checksum;
+    Heap<Var, ActivityLt> binary_heap((ActivityLt(activity)));
+    double binary_time = run(binary_heap, activity, w, binary_checksum);
+
+    DaryHeap<Var, ActivityKey> dary_heap((ActivityKey(activity)));
+    double dary_time = run(dary_heap, activity, w, dary_checksum);
+
+    uint64_t ops = (uint64_t)w.rounds * (2 * w.decisions + opt_bumps);
+    printf("operations            : %-12" PRIu64 "   (%d variables, %d rounds)\n", ops, w.vars, w.rounds);
+    printf("Heap                  : %-12.3f s (%.0f ops/sec)\n", binary_time, ops / binary_time);
+    printf("DaryHeap              : %-12.3f s (%.0f ops/sec)\n", dary_time, ops / dary_time);
+    printf("speedup               : %.2f\n", binary_time / dary_time);
+
+    if (binary_checksum != dary_checksum)
+    {
+        printf("ERROR! The heaps removed different keys (%g vs %g)\n", binary_checksum, dary_checksum);
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,268 @@
+/*****************************************************************************[WatchSearchBench.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <fstream>
+
+#include "solver/mtl/Rnd.h"
+#include "solver/utils/Options.h"
+#include "solver/utils/System.h"
+#include "solver/core/Dimacs.h"
+#include "solver/core/Solver.h"
+#include "solver/core/WatchSearch.h"
+
+#include "core/source/structures/parser.hpp"
+#include "core/source/bench_to_cnf/bench_to_cnf.hpp"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Replacement-watch search microbenchmark -- times the scalar search and the AVX2 one on random
+// clauses with the lengths of the clauses of the given circuits, and finds the minimum length from
+// which the AVX2 search pays off overall:
+//
+// The circuits encode into short clauses, so the long ones are learnt: each circuit is solved for
+// 'conflicts' conflicts and the lengths of its original and learnt clauses are counted then (the
+// clique benchmarks learn long clauses). Each literal of a random clause (from the third on, as in
+// 'propagate()') is false with probability 'false-frac', otherwise true. The cost of a threshold
+// 'T' is the time of searching every counted clause once, with AVX2 for the clauses of at least 'T'
+// literals. The best threshold is printed next to 'Solver::simd_min_size'.
+
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(PACKED_VAR_STATE)
+
+class LengthSolver : public Solver
+{
+public:
+    // Adds the number of original and learnt clauses of each length to 'counts':
+    void countLengths(vec<uint64_t> &counts) const
+    {
+        for (int i = 0; i < clauses.size() + learnts.size(); i++)
+        {
+            const Clause &c = ca[i < clauses.size() ? clauses[i] : learnts[i - clauses.size()]];
+            counts.growTo(c.size() + 1, 0);
+            counts[c.size()]++;
+        }
+    }
+
+    static int simdMinSize() { return simd_min_size; }
+};
+
+// Solves a circuit for 'conflicts' conflicts and adds the lengths of its clauses to 'counts':
+static void countClauseLengths(const char *bench_file, int conflicts, vec<uint64_t> &counts)
+{
+    std::ifstream file(bench_file);
+    if (!file.is_open())
+    {
+        printf("ERROR! Could not open file: %s\n", bench_file), exit(1);
+    }
+
+    auto parser = csat::BenchParser<csat::DAG>();
+    parser.parseStream(file);
+    file.clear();
+    file.seekg(0);
+
+    auto bench_to_cnf_parser = bench_to_cnf::BenchToCNFParser();
+    bench_to_cnf_parser.parseStream(file);
+    file.close();
+
+    char cnf_file_name[] = "/tmp/watch-search-bench-XXXXXX";
+    int fd = mkstemp(cnf_file_name);
+    if (fd < 0)
+    {
+        printf("ERROR! Could not create a temporary file\n"), exit(1);
+    }
+
+    close(fd);
+    std::ofstream cnf_file(cnf_file_name);
+    bench_to_cnf_parser.writeCNFToStream(cnf_file);
+    cnf_file.close();
+
+    LengthSolver S;
+    S.csat_instance = parser.instantiate();
+    gzFile in = gzopen(cnf_file_name, "rb");
+    parse_DIMACS(in, S);
+    gzclose(in);
+    unlink(cnf_file_name);
+
+    vec<Lit> dummy;
+    S.setConfBudget(conflicts);
+    S.solveLimited(dummy);
+    S.countLengths(counts);
+}
+
+// Average time in nanoseconds of one search from the third literal, over 'clauses' clauses of
+// 'size' literals, with the scalar search ('simd == false') or the AVX2 one:
+static double timeSearch(bool simd, const vec<Lit> &lits, int size, const vec<uint8_t> &values, int repeats, uint64_t &checksum)
+{
+    int clauses = lits.size() / size;
+    const Lit *first = &lits[0];
+    const uint8_t *vals = &values[0];
+    double start_time = cpuTime();
+    for (int r = 0; r < repeats; r++)
+    {
+        for (int i = 0; i < clauses; i++)
+        {
+            const Lit *c = first + (size_t)i * size;
+            checksum += simd ? firstNonFalseAVX2(c, 2, size, vals) : firstNonFalse(c, 2, size, vals);
+        }
+    }
+
+    return (cpuTime() - start_time) * 1e9 / ((double)clauses * repeats);
+}
+
+// Time of searching every counted clause once, with AVX2 from 'threshold' literals on:
+static double thresholdTime(int threshold, const vec<uint64_t> &counts, const vec<double> &scalar_ns, const vec<double> &simd_ns)
+{
+    double total = 0;
+    for (int size = 3; size < counts.size(); size++)
+    {
+        total += counts[size] * (size >= threshold ? simd_ns[size] : scalar_ns[size]);
+    }
+
+    return total;
+}
+
+int main(int argc, char **argv)
+{
+    setUsageHelp("USAGE: %s [options] <bench-file> ...\n\n  Times the replacement-watch search on the clause lengths of the given circuits.\n");
+
+    IntOption opt_vars("BENCH", "vars", "Number of variables of the random clauses.", 100000, IntRange(8, INT32_MAX));
+    IntOption opt_clauses("BENCH", "clauses", "Number of random clauses of each length.", 4096, IntRange(1, INT32_MAX));
+    IntOption opt_lits("BENCH", "lits", "Literals to scan for each length and search (in millions).", 2, IntRange(1, INT32_MAX));
+    DoubleOption opt_false_frac("BENCH", "false-frac", "Probability of a literal being false.", 0.9, DoubleRange(0, true, 1, true));
+    IntOption opt_conflicts("BENCH", "conflicts", "Conflicts to learn clauses in for each circuit.", 2000, IntRange(0, INT32_MAX));
+
+    parseOptions(argc, argv, true);
+
+    if (argc < 2)
+    {
+        printf("ERROR! No bench files given\n"), exit(1);
+    }
+
+    if (!simdSupported())
+    {
+        printf("AVX2 is not supported on this machine\n");
+        return 0;
+    }
+
+    vec<uint64_t> counts;
+    for (int i = 1; i < argc; i++)
+    {
+        countClauseLengths(argv[i], opt_conflicts, counts);
+    }
+
+    // The values are true or false ('lbool' bytes), padded to whole words for the gathers:
+    double seed = 91648253;
+    vec<uint8_t> values((opt_vars + 3) & ~3, 0);
+    for (int v = 0; v < opt_vars; v++)
+    {
+        values[v] = drand(seed) < 0.5 ? 0 : 1;
+    }
+
+    // Only the lengths and thresholds up to 'max_printed' are listed, the longer clauses are summed up:
+    const int max_printed = 64;
+    printf("length        clauses    scalar ns     AVX2 ns   speedup\n");
+    vec<double> scalar_ns(counts.size(), 0), simd_ns(counts.size(), 0);
+    uint64_t scalar_checksum = 0, simd_checksum = 0;
+    for (int size = 3; size < counts.size(); size++)
+    {
+        if (counts[size] == 0)
+        {
+            continue;
+        }
+
+        vec<Lit> lits;
+        for (int i = 0; i < opt_clauses * size; i++)
+        {
+            Var v = irand(seed, opt_vars);
+            bool is_false = i % size >= 2 && drand(seed) < opt_false_frac;
+            lits.push(mkLit(v, is_false ? values[v] == 0 : values[v] == 1));
+        }
+
+        int repeats = (int)((opt_lits * 1000000.0) / ((double)opt_clauses * size)) + 1;
+        scalar_ns[size] = timeSearch(false, lits, size, values, repeats, scalar_checksum);
+        simd_ns[size] = timeSearch(true, lits, size, values, repeats, simd_checksum);
+        if (size <= max_printed)
+        {
+            printf("%6d %14" PRIu64 " %12.2f %11.2f %9.2f\n", size, counts[size], scalar_ns[size], simd_ns[size], scalar_ns[size] / simd_ns[size]);
+        }
+    }
+
+    uint64_t longer = 0;
+    double longer_scalar = 0, longer_simd = 0;
+    for (int size = max_printed + 1; size < counts.size(); size++)
+    {
+        longer += counts[size];
+        longer_scalar += counts[size] * scalar_ns[size];
+        longer_simd += counts[size] * simd_ns[size];
+    }
+
+    if (longer > 0)
+    {
+        printf("longer %14" PRIu64 " %12.2f %11.2f %9.2f\n", longer, longer_scalar / longer, longer_simd / longer, longer_scalar / longer_simd);
+    }
+
+    if (scalar_checksum != simd_checksum)
+    {
+        printf("ERROR! The searches found different literals\n");
+        return 1;
+    }
+
+    // Total time of the thresholds, relative to never using AVX2:
+    double scalar_total = thresholdTime(counts.size(), counts, scalar_ns, simd_ns);
+
+    int best = counts.size();
+    double best_total = scalar_total;
+    printf("\nthreshold   relative time\n");
+    for (int t = 3; t <= counts.size(); t++)
+    {
+        if (t < counts.size() && counts[t] == 0)
+        {
+            continue;
+        }
+
+        double total = thresholdTime(t, counts, scalar_ns, simd_ns);
+
+        if (t <= max_printed)
+        {
+            printf("%9d %15.3f\n", t, total / scalar_total);
+        }
+
+        if (total < best_total)
+        {
+            best = t;
+            best_total = total;
+        }
+    }
+
+    printf("\nbest threshold        : %d (%.3f of the scalar time)\n", best, best_total / scalar_total);
+    printf("simd_min_size         : %d (%.3f of the scalar time)\n", LengthSolver::simdMinSize(), thresholdTime(LengthSolver::simdMinSize(), counts, scalar_ns, simd_ns) / scalar_total);
+    return 0;
+}
+
+#else
+
+int main()
+{
+    printf("The AVX2 watch search is not built for this target\n");
+    return 0;
+}
+
+#endif
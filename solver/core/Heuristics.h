@@ -0,0 +1,82 @@
+/***********************************************************************************[Heuristics.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Heuristics_h
+#define Minisat_Heuristics_h
+
+namespace Minisat
+{
+
+    //=================================================================================================
+    // Heuristic choices:
+
+    enum
+    {
+        branch_order = 0,              // The decision order (VSIDS or VMTF).
+        branch_backprop = 1,           // Back propagation from the J-frontiers to the inputs.
+        branch_jfrontier_activity = 2  // The most active operand of a J-frontier.
+    };
+
+    enum
+    {
+        xor_indifferent = 0,
+        xor_prefer = 1,
+        xor_avoid = 2
+    };
+
+    enum
+    {
+        polarity_default = 0,      // 'DEFAULT_POLARITY_VALUE' for all variables.
+        polarity_max_prob = 1,     // The value each gate takes with the highest probability.
+        polarity_max_backprop = 2  // The value each gate propagates most backwards from.
+    };
+
+    //=================================================================================================
+    // Branching policies -- the search loop is instantiated for each of them ('Solver::searchWith()'),
+    // so the choice between them is made once per restart and the decisions compile as if there
+    // were only one:
+
+    // Decide on the next variable of the decision order, with random decisions and user polarities:
+    struct OrderBranching
+    {
+        static const int kind = branch_order;
+        static const bool circuit = false;
+    };
+
+    // Decide on the unassigned operand of a J-frontier that is closest to an output. Ties are broken
+    // by activity if 'Activity' is set. With 'Xor' other than 'xor_indifferent', an operand of the
+    // preferred kind (XOR-like gate or not) wins over any other:
+    template <bool Activity, int Xor>
+    struct BackpropBranching
+    {
+        static const int kind = branch_backprop;
+        static const bool circuit = true;
+        static const bool activity = Activity;
+        static const int xor_preference = Xor;
+    };
+
+    // Decide on the most active unassigned operand of a J-frontier:
+    struct JFrontierActivityBranching
+    {
+        static const int kind = branch_jfrontier_activity;
+        static const bool circuit = true;
+    };
+
+    //=================================================================================================
+}
+
+#endif
@@ -0,0 +1,354 @@
+/*********************************************************************************[LocalSearch.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+
+#include "solver/core/LocalSearch.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Parameters:
+
+static const int    ls_samples = 4;   // Number of inputs sampled per step.
+static const double ls_cb      = 2.5; // Base of the probability of a flip, as a function of its gain.
+static const int    ls_max_gain = 16; // The gains are clamped to +/- this value.
+
+//=================================================================================================
+// Constructor:
+
+LocalSearch::LocalSearch(const csat::DAG &_dag) :
+    flips(0),
+    dag(_dag),
+    n_gates((int)_dag.getNumberOfGates()),
+    mark(0),
+    score(0),
+    best_score(0),
+    max_score(0)
+{
+    // Topological levels, by counting the operands that still need a level:
+    vec<int> pending(n_gates, 0);
+    level.growTo(n_gates, 0);
+    for (Var g = 0; g < n_gates; g++)
+    {
+        pending[g] = (int)dag.getGateOperands(g).size();
+        if (pending[g] == 0)
+        {
+            order.push(g);
+        }
+    }
+
+    int max_level = 0;
+    for (int i = 0; i < order.size(); i++)
+    {
+        Var g = order[i];
+        for (size_t user : dag.getGateUsers(g))
+        {
+            if (level[user] < level[g] + 1)
+            {
+                level[user] = level[g] + 1;
+                max_level = level[user] > max_level ? level[user] : max_level;
+            }
+
+            if (--pending[user] == 0)
+            {
+                order.push(user);
+            }
+        }
+    }
+
+    buckets.growTo(max_level + 1);
+    queued.growTo(n_gates, 0);
+    values.growTo(n_gates, 0);
+    can_flip.growTo(n_gates, 0);
+
+    // Outputs and the inputs of their fan-in cones:
+    const std::vector<size_t> &outputs = dag.getOutputGates();
+    output_index.growTo(n_gates, -1);
+    out_score.growTo((int)outputs.size(), 0);
+    out_mark.growTo((int)outputs.size(), 0);
+    cone_inputs.growTo((int)outputs.size());
+
+    vec<char> visited(n_gates, 0);
+    vec<Var> stack, cone;
+    for (int o = 0; o < (int)outputs.size(); o++)
+    {
+        output_index[outputs[o]] = o;
+        max_score += (int)dag.getGateOperands(outputs[o]).size() + 1;
+
+        cone.clear();
+        stack.push(outputs[o]);
+        visited[outputs[o]] = 1;
+        while (stack.size() > 0)
+        {
+            Var g = stack.last();
+            stack.pop();
+            cone.push(g);
+            if (dag.getGateType(g) == csat::GateType::INPUT)
+            {
+                cone_inputs[o].push(g);
+            }
+
+            for (size_t operand : dag.getGateOperands(g))
+            {
+                if (!visited[operand])
+                {
+                    visited[operand] = 1;
+                    stack.push(operand);
+                }
+            }
+        }
+
+        for (int i = 0; i < cone.size(); i++)
+        {
+            visited[cone[i]] = 0;
+        }
+    }
+}
+
+//=================================================================================================
+// Simulation:
+
+bool LocalSearch::eval(Var g) const
+{
+    const std::vector<size_t> &ops = dag.getGateOperands(g);
+    switch (dag.getGateType(g))
+    {
+    case csat::GateType::AND:
+    case csat::GateType::NAND:
+    {
+        bool result = true;
+        for (size_t op : ops)
+        {
+            result = result && values[op];
+        }
+
+        return dag.getGateType(g) == csat::GateType::AND ? result : !result;
+    }
+    case csat::GateType::OR:
+    case csat::GateType::NOR:
+    {
+        bool result = false;
+        for (size_t op : ops)
+        {
+            result = result || values[op];
+        }
+
+        return dag.getGateType(g) == csat::GateType::OR ? result : !result;
+    }
+    case csat::GateType::XOR:
+    case csat::GateType::NXOR:
+    {
+        bool result = false;
+        for (size_t op : ops)
+        {
+            result = result != (bool)values[op];
+        }
+
+        return dag.getGateType(g) == csat::GateType::XOR ? result : !result;
+    }
+    case csat::GateType::NOT:
+        return !values[ops[0]];
+    case csat::GateType::BUFF:
+        return values[ops[0]];
+    default:
+        return values[g];
+    }
+}
+
+int LocalSearch::outputScore(Var o) const
+{
+    const std::vector<size_t> &ops = dag.getGateOperands(o);
+    if (values[o])
+    {
+        return (int)ops.size() + 1;
+    }
+
+    // Count the operands that already have the value needed for a true output:
+    csat::GateType type = dag.getGateType(o);
+    if (type != csat::GateType::AND && type != csat::GateType::NOR)
+    {
+        return 0;
+    }
+
+    int n = 0;
+    for (size_t op : ops)
+    {
+        n += (bool)values[op] == (type == csat::GateType::AND);
+    }
+
+    return n;
+}
+
+int LocalSearch::flip(Var x)
+{
+    values[x] ^= 1;
+    changed.clear();
+    changed.push(x);
+
+    int lo = level[x] + 1, hi = lo - 1;
+    for (size_t user : dag.getGateUsers(x))
+    {
+        if (!queued[user])
+        {
+            queued[user] = 1;
+            buckets[level[user]].push(user);
+            hi = level[user] > hi ? level[user] : hi;
+        }
+    }
+
+    // Every gate is evaluated after all of its operands:
+    for (int l = lo; l <= hi; l++)
+    {
+        for (int i = 0; i < buckets[l].size(); i++)
+        {
+            Var g = buckets[l][i];
+            queued[g] = 0;
+            if (eval(g) == (bool)values[g])
+            {
+                continue;
+            }
+
+            values[g] ^= 1;
+            changed.push(g);
+            for (size_t user : dag.getGateUsers(g))
+            {
+                if (!queued[user])
+                {
+                    queued[user] = 1;
+                    buckets[level[user]].push(user);
+                    hi = level[user] > hi ? level[user] : hi;
+                }
+            }
+        }
+
+        buckets[l].clear();
+    }
+
+    // Rescore the outputs that changed or had an operand changed:
+    mark++;
+    for (int i = 0; i < changed.size(); i++)
+    {
+        Var g = changed[i];
+        for (int k = -1; k < (int)dag.getGateUsers(g).size(); k++)
+        {
+            Var o = k < 0 ? g : (Var)dag.getGateUsers(g)[k];
+            int idx = output_index[o];
+            if (idx >= 0 && out_mark[idx] != mark)
+            {
+                out_mark[idx] = mark;
+                int s = outputScore(o);
+                score += s - out_score[idx];
+                out_score[idx] = s;
+            }
+        }
+    }
+
+    return score;
+}
+
+//=================================================================================================
+// Search:
+
+bool LocalSearch::search(const vec<char> &init, const vec<char> &fixed, uint64_t max_flips, double &seed)
+{
+    const std::vector<size_t> &outputs = dag.getOutputGates();
+
+    // Simulate the circuit from the initial inputs:
+    for (int i = 0; i < order.size(); i++)
+    {
+        Var g = order[i];
+        bool input = dag.getGateType(g) == csat::GateType::INPUT;
+        can_flip[g] = input && !fixed[g];
+        values[g] = input ? init[g] : eval(g);
+    }
+
+    score = 0;
+    for (int o = 0; o < (int)outputs.size(); o++)
+    {
+        out_score[o] = outputScore(outputs[o]);
+        score += out_score[o];
+    }
+
+    best_score = score;
+    values.copyTo(best_values);
+
+    vec<Var> unsat, candidates;
+    vec<double> weights;
+    for (uint64_t f = 0; f < max_flips && score < max_score; f++)
+    {
+        unsat.clear();
+        for (int o = 0; o < (int)outputs.size(); o++)
+        {
+            if (!values[outputs[o]])
+            {
+                unsat.push(o);
+            }
+        }
+
+        const vec<Var> &cone = cone_inputs[unsat[irand(seed, unsat.size())]];
+        if (cone.size() == 0)
+        {
+            break;
+        }
+
+        // Sample inputs of the cone and score their flips:
+        candidates.clear();
+        weights.clear();
+        double total = 0;
+        for (int k = 0; k < ls_samples * 2 && candidates.size() < ls_samples; k++)
+        {
+            Var x = cone[irand(seed, cone.size())];
+            if (!can_flip[x])
+            {
+                continue;
+            }
+
+            int before = score;
+            int gain = flip(x) - before;
+            flip(x);
+            gain = gain > ls_max_gain ? ls_max_gain : gain < -ls_max_gain ? -ls_max_gain : gain;
+
+            candidates.push(x);
+            weights.push(pow(ls_cb, gain));
+            total += weights.last();
+        }
+
+        if (candidates.size() == 0)
+        {
+            continue;
+        }
+
+        double r = drand(seed) * total;
+        int pick = 0;
+        while (pick < candidates.size() - 1 && (r -= weights[pick]) > 0)
+        {
+            pick++;
+        }
+
+        flip(candidates[pick]);
+        flips++;
+
+        if (score > best_score)
+        {
+            best_score = score;
+            values.copyTo(best_values);
+        }
+    }
+
+    return best_score == max_score;
+}
@@ -0,0 +1,92 @@
+/**********************************************************************************[LocalSearch.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_LocalSearch_h
+#define Minisat_LocalSearch_h
+
+#include "solver/mtl/Vec.h"
+#include "solver/core/SolverTypes.h"
+
+#include "core/source/structures/parser.hpp"
+
+namespace Minisat
+{
+
+    //=================================================================================================
+    // LocalSearch -- a probSAT-like stochastic search over the primary inputs of a circuit:
+    //
+    // All gates are simulated from the inputs; a flip of an input re-simulates its fan-out cone in
+    // topological order. The score of an assignment counts the true outputs, each weighted by its
+    // number of operands plus one, and for the outputs that are not true (yet) the operands that
+    // have the value required by an AND/NOR output (these are typically the single constraints of
+    // the instance). A step picks an output that is not true, samples some inputs of its fan-in
+    // cone and flips one of them with a probability growing exponentially with its score gain.
+
+    class LocalSearch
+    {
+    public:
+        explicit LocalSearch(const csat::DAG &dag);
+
+        // Searches for input values that make all outputs true, starting from 'init' (a value for
+        // every gate, only those of the inputs are used). Inputs with 'fixed' set are never flipped.
+        // Returns TRUE if all outputs became true within 'max_flips' flips:
+        bool search(const vec<char> &init, const vec<char> &fixed, uint64_t max_flips, double &seed);
+
+        const vec<char> &bestValues() const { return best_values; } // The gate values of the best assignment.
+        int bestScore() const { return best_score; }
+        int maxScore() const { return max_score; }
+
+        // Statistics: (read-only member variable)
+        //
+        uint64_t flips;
+
+    protected:
+        const csat::DAG &dag;
+        int n_gates;
+        vec<Var> order;              // All gates in topological order.
+        vec<int> level;              // Topological level of each gate (0 for the inputs).
+        vec<vec<Var> > buckets;      // Gates to re-simulate, by level.
+        vec<char> queued;
+        vec<Var> changed;            // Gates changed by the last flip.
+        vec<int> output_index;       // Index of each gate in the outputs (-1 if no output).
+        vec<vec<Var> > cone_inputs;  // Inputs in the fan-in cone of each output.
+        vec<int> out_score;          // Current score of each output.
+        vec<uint32_t> out_mark;
+        uint32_t mark;
+
+        vec<char> values, best_values, can_flip;
+        int score, best_score, max_score;
+
+        bool eval(Var g) const;
+        int outputScore(Var o) const;
+        int flip(Var x); // Flips an input and re-simulates its fan-out cone, returns the new score.
+
+        static inline double drand(double &seed)
+        {
+            seed *= 1389796;
+            int q = (int)(seed / 2147483647);
+            seed -= (double)q * 2147483647;
+            return seed / 2147483647;
+        }
+
+        static inline int irand(double &seed, int size) { return (int)(drand(seed) * size); }
+    };
+
+    //=================================================================================================
+}
+
+#endif
@@ -24,11 +24,14 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include <fstream>
 
 #include "solver/utils/System.h"
+#include "solver/utils/Interrupts.h"
 #include "solver/utils/ParseUtils.h"
 #include "solver/utils/Options.h"
 #include "solver/core/Dimacs.h"
 #include "solver/core/Solver.h"
 #include "solver/core/Config.h"
+#include "solver/parallel/CubeAndConquer.h"
+#include "solver/parallel/Portfolio.h"
 
 #include "core/source/structures/parser.hpp"
 #include "core/source/bench_to_cnf/bench_to_cnf.hpp"
@@ -37,10 +40,14 @@ using namespace Minisat;
 
 //=================================================================================================
 
-static Solver *solver;
-// Terminate by notifying the solver and back out gracefully. This is mainly to have a test-case
+static InterruptRegistry interrupts; // The solvers (and parallel modes) that are running.
+
+// Terminate by notifying the solvers and back out gracefully. This is mainly to have a test-case
 // for this feature of the Solver as it may take longer than an immediate call to '_exit()'.
-static void SIGINT_interrupt(int) { solver->interrupt(); }
+static void SIGINT_interrupt(int)
+{
+    interrupts.broadcast();
+}
 
 // Note that '_exit()' rather than 'exit()' has to be used. The reason is that 'exit()' calls
 // destructors and may cause deadlocks if a malloc/free function happens to be running (these
@@ -49,13 +56,6 @@ static void SIGINT_exit(int)
 {
     printf("\n");
     printf("*** INTERRUPTED ***\n");
-    if (solver->verbosity > 0)
-    {
-        solver->printStats();
-        printf("\n");
-        printf("*** INTERRUPTED ***\n");
-    }
-
     _exit(1);
 }
 
@@ -76,18 +76,15 @@ int main(int argc, char **argv)
         IntOption mem_lim("MAIN", "mem-lim", "Limit on memory usage in megabytes.\n", 0, IntRange(0, INT32_MAX));
         BoolOption strictp("MAIN", "strict", "Validate DIMACS header during parsing.", false);
         BoolOption verify("MAIN", "verify", "Verify satisfying set if it is found.", false);
+        BoolOption mmap_arena("MAIN", "mmap-arena", "Reserve address space for the clause arena and commit it on demand (not with mem-lim).", true);
+        BoolOption huge_pages("MAIN", "huge-pages", "Use transparent huge pages for the clause arena and variable maps.", true);
+        BoolOption numa_bind("MAIN", "numa-bind", "Bind the clause arena and variable maps to the NUMA node of the solving thread.", false);
+        IntOption cubes("MAIN", "cubes", "Split the problem into this many cubes by lookahead and solve them in parallel (0=off).\n", 0, IntRange(0, INT32_MAX));
+        IntOption threads("MAIN", "threads", "Number of solver threads, running a portfolio of configurations unless splitting into cubes (the CPU time limit counts all threads).\n", 1, IntRange(1, 1024));
 
         parseOptions(argc, argv, true);
 
-        Solver S;
-        solver = &S;
-        S.verbosity = verb;
-
-        // Use signal handlers that forcibly quit until the solver will be able to respond to
-        // interrupts:
-        sigTerm(SIGINT_exit);
-
-        // Try to set resource limits:
+        // Try to set resource limits (the memory limit also decides how the solver allocates):
         if (cpu_lim != 0)
         {
             limitTime(cpu_lim);
@@ -98,6 +95,18 @@ int main(int argc, char **argv)
             limitMemory(mem_lim);
         }
 
+        memory_policy.mmap_arena = mmap_arena;
+        memory_policy.huge_pages = huge_pages;
+        memory_policy.numa_bind = numa_bind;
+
+        Solver S;
+        S.verbosity = verb;
+        InterruptScope interrupt_solver(interrupts, S);
+
+        // Use signal handlers that forcibly quit until the solver will be able to respond to
+        // interrupts:
+        sigTerm(SIGINT_exit);
+
         if (argc == 1)
         {
             printf("ERROR! Not enough arguments"), exit(1);
@@ -186,12 +195,67 @@ int main(int argc, char **argv)
             exit(20);
         }
 
-        vec<Lit> dummy;
-        lbool ret = S.solveLimited(dummy);
-        if (S.verbosity > 0)
+        // Every thread of a parallel mode loads the problem into its own solver:
+        auto load = [&](Solver &W) {
+            W.csat_instance = csat_instance;
+            gzFile in = gzopen(cnf_file_name, "rb");
+            parse_DIMACS(in, W, (bool)strictp);
+            gzclose(in);
+        };
+
+        lbool ret;
+        if (cubes > 0)
         {
-            S.printStats();
-            printf("\n");
+            CubeAndConquer cc(S, load, threads);
+            InterruptScope interrupt_cubes(interrupts, cc);
+            ret = cc.solve(cubes);
+            if (ret == l_True)
+            {
+                cc.model.copyTo(S.model);
+            }
+
+            if (S.verbosity > 0)
+            {
+                printf("===============================================================================\n");
+                printf("cubes                 : %-12d   (%d refuted, %d pruned by cores)\n", cc.cubes, cc.refuted_cubes, cc.pruned_cubes);
+                printf("conflicts             : %-12" PRIu64 "   (all threads)\n", cc.conflicts);
+                printf("decisions             : %-12" PRIu64 "   (all threads)\n", cc.decisions);
+                printf("propagations          : %-12" PRIu64 "   (all threads)\n", cc.propagations);
+                if (threads > 1)
+                {
+                    printf("shared clauses        : %-12" PRIu64 "   (%" PRIu64 " imported, %" PRIu64 " useful)\n", cc.shared_exported, cc.shared_imported, cc.shared_useful);
+                }
+                printf("CPU time              : %g s\n", cpuTime());
+                printf("\n");
+            }
+        }
+        else if (threads > 1)
+        {
+            Portfolio portfolio(load, threads);
+            InterruptScope interrupt_portfolio(interrupts, portfolio);
+            ret = portfolio.solve();
+            if (ret == l_True)
+            {
+                portfolio.model.copyTo(S.model);
+            }
+
+            if (S.verbosity > 0 && portfolio.winner >= 0)
+            {
+                printf("===============================================================================\n");
+                printf("portfolio winner      : thread %d (%s)\n", portfolio.winner, portfolio.configName(portfolio.winner));
+                portfolio.solver(portfolio.winner).printStats();
+                printf("\n");
+            }
+        }
+        else
+        {
+            vec<Lit> dummy;
+            ret = S.solveLimited(dummy);
+            if (S.verbosity > 0)
+            {
+                S.printStats();
+                printf("\n");
+            }
         }
 
         printf(ret == l_True ? "SATISFIABLE\n" : ret == l_False ? "UNSATISFIABLE\n"
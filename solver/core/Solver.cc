@@ -19,6 +19,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 **************************************************************************************************/
 
 #include <math.h>
+#include <algorithm>
 #include <queue>
 #include <unordered_set>
 
@@ -27,6 +28,9 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #include "solver/utils/System.h"
 #include "solver/core/Solver.h"
 #include "solver/core/Config.h"
+#include "solver/core/LocalSearch.h"
+#include "solver/core/WatchSearch.h"
+#include "solver/parallel/ClauseExchange.h"
 
 using namespace Minisat;
 
@@ -40,7 +44,35 @@ static DoubleOption opt_clause_decay(_cat, "cla-decay", "The clause activity dec
 static DoubleOption opt_random_var_freq(_cat, "rnd-freq", "The frequency with which the decision heuristic tries to choose a random variable", 0, DoubleRange(0, true, 1, true));
 static DoubleOption opt_random_seed(_cat, "rnd-seed", "Used by the random variable selection", 91648253, DoubleRange(0, false, HUGE_VAL, false));
 static IntOption opt_ccmin_mode(_cat, "ccmin-mode", "Controls conflict clause minimization (0=none, 1=basic, 2=deep)", CCMIN_MODE, IntRange(0, 2));
+static IntOption opt_bin_min_glue(_cat, "bin-min-glue", "Minimize learnt clauses up to this glue with the binary clauses of the asserting literal (0=never)", 6, IntRange(0, INT32_MAX));
+static IntOption opt_decision_order(_cat, "order", "Controls the decision order (0=activity heap, 1=VMTF queue)", 0, IntRange(0, 1));
+static IntOption opt_chrono(_cat, "chrono", "Backtrack chronologically if a backjump would undo more than this number of levels (-1=never)", -1, IntRange(-1, INT32_MAX));
 static IntOption opt_phase_saving(_cat, "phase-saving", "Controls the level of phase saving (0=none, 1=limited, 2=full)", 2, IntRange(0, 2));
+static BoolOption opt_simd(_cat, "simd", "Search for new watches in long clauses with AVX2 (if the CPU supports it)", true);
+static BoolOption opt_gc_locality(_cat, "gc-locality", "Lay out clauses in the order propagation visits them when collecting garbage", false);
+static BoolOption opt_reuse_trail(_cat, "reuse-trail", "Keep the decision levels that would be re-decided identically on restart", false);
+static IntOption opt_rephase_int(_cat, "rephase-int", "Base number of conflicts between resets of the saved phases, grows arithmetically (0=never)", 0, IntRange(0, INT32_MAX));
+static BoolOption opt_target_phase(_cat, "target-phase", "Decide on the phases of the longest conflict-free trail", false);
+static IntOption opt_branching(_cat, "branching", "Branching heuristic (0=decision order, 1=back propagation from the J-frontiers, 2=most active J-frontier operand)", branch_backprop, IntRange(0, 2));
+static BoolOption opt_bp_activity(_cat, "bp-activity", "Break distance ties of the back propagation by activity", false);
+static IntOption opt_bp_xor(_cat, "bp-xor", "XOR gates in the back propagation (0=no preference, 1=prefer, 2=avoid)", xor_indifferent, IntRange(0, 2));
+static IntOption opt_csat_start(_cat, "csat-start", "Restarts made with the circuit branching heuristic before the decision order takes over (0=never)", 0, IntRange(0, INT32_MAX));
+static IntOption opt_polarity_init(_cat, "polarity-init", "Initial polarities from the circuit (0=none, 1=max probability, 2=max back propagation)", polarity_default, IntRange(0, 2));
+static BoolOption opt_podem(_cat, "podem", "Decide only on circuit inputs, backtraced from an unjustified J-frontier gate by controllability (with -branching=1)", false);
+static IntOption opt_inprocess_int(_cat, "inprocess-int", "Base number of conflicts between inprocessing rounds, grows arithmetically (0=never)", 0, IntRange(0, INT32_MAX));
+static IntOption opt_ls_int(_cat, "ls-int", "Base number of conflicts between local search rounds on the circuit inputs, grows arithmetically (0=never)", 0, IntRange(0, INT32_MAX));
+static IntOption opt_ls_flips(_cat, "ls-flips", "Number of flips of each local search round", 10000, IntRange(1, INT32_MAX));
+static IntOption opt_share_glue(_cat, "share-glue", "Initial glue limit of the learnt clauses shared with other threads, adapted to the sharing rate (0=never)", 2, IntRange(0, ClauseExchange::max_size));
+static IntOption opt_share_size(_cat, "share-size", "Size limit of the learnt clauses shared with other threads", ClauseExchange::max_size, IntRange(1, ClauseExchange::max_size));
+static BoolOption opt_probe(_cat, "probe", "Probe for failed literals on binary implication roots and high-fanout gates when inprocessing", true);
+static BoolOption opt_substitute(_cat, "substitute", "Substitute equivalent literals found in the binary implication graph when inprocessing", true);
+static BoolOption opt_vivify(_cat, "vivify", "Vivify the most active learnt clauses when inprocessing", true);
+static DoubleOption opt_subsume_time(_cat, "subsume-time", "Time limit in seconds of each subsumption pass (0=never)", 1.0, DoubleRange(0, true, HUGE_VAL, false));
+static Int64Option opt_subsume_steps(_cat, "subsume-steps", "Step limit of each subsumption pass, in clause occurrences and literals visited (0=none)", 100000000, Int64Range(0, INT64_MAX));
+static IntOption opt_elim(_cat, "elim", "Eliminate the variables that are not frozen before solving (0=never, 1=always, 2=only with -branching=0)", 2, IntRange(0, 2));
+static IntOption opt_elim_grow(_cat, "grow", "Allow a variable elimination step to grow by a number of clauses", 0);
+static IntOption opt_elim_clause_lim(_cat, "cl-lim", "Variables are not eliminated if it produces a resolvent with a length above this limit (-1=no limit)", 20, IntRange(-1, INT32_MAX));
+static DoubleOption opt_inprocess_effort(_cat, "inprocess-effort", "Propagation budget of each inprocessing technique relative to the search propagations since the last round", 0.1, DoubleRange(0, false, HUGE_VAL, false));
 static BoolOption opt_rnd_init_act(_cat, "rnd-init", "Randomize the initial activity", false);
 static BoolOption opt_luby_restart(_cat, "luby", "Use the Luby restart sequence", true);
 static IntOption opt_restart_first(_cat, "rfirst", "The base restart interval", RFIRST, IntRange(1, INT32_MAX));
@@ -51,15 +83,13 @@ static IntOption opt_min_learnts_lim(_cat, "min-learnts", "Minimum learnt clause
 //=================================================================================================
 // Constructor/Destructor:
 
-Solver::Solver() :
-    // Parameters (user settable):
-    //
+SolverConfig::SolverConfig() :
     verbosity(0),
     var_decay(opt_var_decay),
     clause_decay(opt_clause_decay),
     random_var_freq(opt_random_var_freq),
     random_seed(opt_random_seed),
-    luby_restart(opt_luby_restart), ccmin_mode(opt_ccmin_mode), phase_saving(opt_phase_saving), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(opt_garbage_frac), min_learnts_lim(opt_min_learnts_lim), restart_first(opt_restart_first), restart_inc(opt_restart_inc),
+    luby_restart(opt_luby_restart), ccmin_mode(opt_ccmin_mode), bin_min_glue(opt_bin_min_glue), decision_order(opt_decision_order), chrono(opt_chrono), phase_saving(opt_phase_saving), reuse_trail(opt_reuse_trail), gc_locality(opt_gc_locality), simd_watch_search(opt_simd && simdSupported()), rephase_int(opt_rephase_int), target_phase(opt_target_phase), branching(opt_branching), bp_activity(opt_bp_activity), bp_xor(opt_bp_xor), csat_start(opt_csat_start), polarity_init(opt_polarity_init), podem(opt_podem), inprocess_int(opt_inprocess_int), ls_int(opt_ls_int), ls_flips(opt_ls_flips), share_glue(opt_share_glue), share_size(opt_share_size), inprocess_effort(opt_inprocess_effort), subsume_time(opt_subsume_time), subsume_steps(opt_subsume_steps), use_probe(opt_probe), use_substitute(opt_substitute), use_vivify(opt_vivify), use_elim(opt_elim), grow(opt_elim_grow), clause_lim(opt_elim_clause_lim), rnd_pol(false), rnd_init_act(opt_rnd_init_act), garbage_frac(opt_garbage_frac), min_learnts_lim(opt_min_learnts_lim), restart_first(opt_restart_first), restart_inc(opt_restart_inc),
 
     // Parameters (the rest):
     //
@@ -69,7 +99,14 @@ Solver::Solver() :
     // Parameters (experimental):
     //
     learntsize_adjust_start_confl(100),
-    learntsize_adjust_inc(1.5),
+    learntsize_adjust_inc(1.5)
+{
+}
+
+Solver::Solver(const SolverConfig &config) :
+    // Parameters:
+    //
+    SolverConfig(config),
 
     // Statistics: (formerly in 'SolverStats')
     //
@@ -79,14 +116,50 @@ Solver::Solver() :
     rnd_decisions(0),
     propagations(0),
     conflicts(0),
+    chrono_backtracks(0),
     dec_vars(0),
     num_clauses(0),
     num_learnts(0),
     clauses_literals(0),
     learnts_literals(0),
     max_literals(0), tot_literals(0),
+    reused_levels(0),
+    rephases(0),
+    inprocessings(0),
+    cache_misses(0),
+    bin_min_literals(0),
+    subsumed_clauses(0),
+    strengthened_clauses(0),
+    eliminated_vars(0),
+    probe_units(0),
+    probe_hbrs(0),
+    substituted_vars(0),
+    podem_decisions(0),
+    shared_exported(0),
+    shared_imported(0),
+    shared_useful(0),
+    ls_calls(0),
+    ls_flips_total(0),
+    exchange(NULL),
+    exchange_id(0),
+#ifdef PACKED_VAR_STATE
+    assigns(var_state),
+    polarity(var_state),
+#endif
+    target_assigned(0),
+    best_assigned(0),
+    next_rephase(rephase_int),
+    next_local_search(ls_int),
+#ifdef PACKED_VAR_STATE
+    vardata(var_state),
+#endif
     watches(WatcherDeleted(ca)),
+#ifdef DARY_ORDER_HEAP
+    order_heap(VarOrderKey(activity)),
+#else
     order_heap(VarOrderLt(activity)),
+#endif
+    vmtf_queue(var_Undef),
     ok(true),
     cla_inc(1),
     var_inc(1),
@@ -96,6 +169,20 @@ Solver::Solver() :
     progress_estimate(0),
     remove_satisfied(true),
     next_var(0),
+#ifdef PACKED_VAR_STATE
+    seen(var_state),
+#endif
+    stamp(0),
+    preprocessed(false),
+    next_inprocess(inprocess_int),
+    inprocess_props(0),
+    exchange_cursor(0),
+    export_glue(share_glue),
+    export_window(0),
+    next_share_adjust(share_period),
+    cache_miss_counter(-1),
+    gc_misses(0),
+    gc_propagations(0),
 
     // Resource constraints:
     //
@@ -103,10 +190,15 @@ Solver::Solver() :
     propagation_budget(-1),
     asynch_interrupt(false)
 {
+    addTechnique("probe", &Solver::probe, use_probe);
+    addTechnique("substitute", &Solver::substituteEquivalences, use_substitute);
+    addTechnique("vivify", &Solver::vivifyLearnts, use_vivify);
+    addTechnique("subsume", &Solver::subsumeLearnts, subsume_time > 0);
 }
 
 Solver::~Solver()
 {
+    closeCacheMissCounter(cache_miss_counter);
 }
 
 //=================================================================================================
@@ -130,18 +222,31 @@ Var Solver::newVar(lbool upol, bool dvar)
 
     watches.init(mkLit(v, false));
     watches.init(mkLit(v, true));
+#ifndef PACKED_VAR_STATE
+    // The AVX2 watch search reads the values in whole 32-bit words, so the map is padded to them:
+    assigns.reserve(v | 3, l_Undef);
+#endif
     assigns.insert(v, l_Undef);
     vardata.insert(v, mkVarData(CRef_Undef, 0));
     activity.insert(v, rnd_init_act ? drand(random_seed) * 0.00001 : 0);
     seen.insert(v, 0);
+    var_stamp.insert(v, 0);
+    level_stamp.push(0);
+    frozen.insert(v, 0);
+    representative.insert(v, mkLit(v));
+    eliminated.insert(v, 0);
     polarity.insert(v, DEFAULT_POLARITY_VALUE);
-
-#if defined CSAT_HEURISTIC_START && RESET_POLARITY && defined POLARITY_INIT_HEURISTIC
+    target_polarity.insert(v, l_Undef);
+    best_polarity.insert(v, l_Undef);
     polarity_copy.insert(v, DEFAULT_POLARITY_VALUE);
-#endif
 
     user_pol.insert(v, upol);
     decision.reserve(v);
+    if (!vmtf_queue.inQueue(v))
+    {
+        vmtf_queue.insert(v);
+    }
+
     trail.capacity(v + 1);
     setDecisionVar(v, dvar);
     return v;
@@ -273,28 +378,34 @@ bool Solver::satisfied(const Clause &c) const
     return false;
 }
 
-// Revert to the state at given level (keeping all assignment at 'level' but not beyond).
+// Revert to the state at given level (keeping all assignment at 'level' but not beyond). After
+// chronological backtracking the trail may hold literals of a lower level above 'trail_lim[level]',
+// these are kept (in order) and propagated again.
 //
 void Solver::cancelUntil(int level)
 {
     if (decisionLevel() > level)
     {
+        add_tmp.clear();
         for (int c = trail.size() - 1; c >= trail_lim[level]; c--)
         {
             Var x = var(trail[c]);
-            assigns[x] = l_Undef;
+            if (this->level(x) <= level)
+            {
+                add_tmp.push(trail[c]);
+                continue;
+            }
 
-#if defined BACKPROP || defined JFRONTIERS_ACTIVITY
-            jFrontiers.erase(x);
+            assigns[x] = l_Undef;
 
-            for (Var user : csat_instance.get()->getGateUsers(x))
+            if (branching != branch_order)
             {
-                if (assigns[user] != l_Undef)
+                unassignJFrontier(x);
+                for (int i = 0; x < substituted.size() && i < substituted[x].size(); i++)
                 {
-                    jFrontiers.insert(user);
+                    unassignJFrontier(substituted[x][i]);
                 }
             }
-#endif
 
             if (phase_saving > 1 || (phase_saving == 1 && c > trail_lim.last()))
             {
@@ -307,14 +418,23 @@ void Solver::cancelUntil(int level)
         qhead = trail_lim[level];
         trail.shrink(trail.size() - trail_lim[level]);
         trail_lim.shrink(trail_lim.size() - level);
+        for (int i = add_tmp.size() - 1; i >= 0; i--)
+        {
+            trail.push_(add_tmp[i]);
+        }
+
+        add_tmp.clear();
     }
 }
 
 //=================================================================================================
 // Major methods:
 
-#if defined POLARITY_INIT_MAXPROB || defined POLARITY_INIT_MAXBACKPROP
-void Solver::setDefaultPolarities()
+// Sets 'polarity' to circuit-derived phases: 'max_prob' prefers the value each gate takes with the
+// highest probability on random inputs, otherwise the value from which it propagates most backwards
+// to its operands.
+//
+void Solver::circuitPolarities(bool max_prob)
 {
     std::unordered_map<int, std::pair<int, int>> polarities;
     for (int i = 0; i < clauses.size(); ++i)
@@ -337,15 +457,14 @@ void Solver::setDefaultPolarities()
         }
     }
 
+    csat::GateType true_type_a = max_prob ? csat::GateType::AND : csat::GateType::OR;
+    csat::GateType true_type_b = max_prob ? csat::GateType::NOR : csat::GateType::NAND;
+
     int n_vars = nVars();
     for (int var = 0; var < n_vars; ++var)
     {
         auto operation = csat_instance.get()->getGateType(var);
-#ifdef POLARITY_INIT_MAXPROB
-        if (operation == csat::GateType::AND || operation == csat::GateType::NOR)
-#elif defined POLARITY_INIT_MAXBACKPROP
-        if (operation == csat::GateType::OR || operation == csat::GateType::NAND)
-#endif
+        if (operation == true_type_a || operation == true_type_b)
         {
             polarity[var] = true;
         }
@@ -353,15 +472,8 @@ void Solver::setDefaultPolarities()
         {
             auto operand = csat_instance.get()->getGateOperands(var)[0];
             auto operand_operation = csat_instance.get()->getGateType(operand);
-#ifdef POLARITY_INIT_MAXPROB
-            if ((operand_operation != csat::GateType::INPUT && operand_operation != csat::GateType::AND && operand_operation != csat::GateType::NOR) ||
-#elif defined POLARITY_INIT_MAXBACKPROP
-            if ((operand_operation != csat::GateType::INPUT && operand_operation != csat::GateType::OR && operand_operation != csat::GateType::NAND) ||
-#endif
-                (operand_operation == csat::GateType::INPUT && polarities[operand].first < polarities[operand].second))
-            {
-                polarity[var] = true;
-            }
+            polarity[var] = (operand_operation != csat::GateType::INPUT && operand_operation != true_type_a && operand_operation != true_type_b) ||
+                            (operand_operation == csat::GateType::INPUT && polarities[operand].first < polarities[operand].second);
         }
         else if (operation == csat::GateType::INPUT)
         {
@@ -377,17 +489,22 @@ void Solver::setDefaultPolarities()
             polarity[var] = false;
         }
     }
+}
 
-#if defined CSAT_HEURISTIC_START && RESET_POLARITY
-    for (int var = 0; var < n_vars; ++var)
+void Solver::setDefaultPolarities()
+{
+    circuitPolarities(polarity_init == polarity_max_prob);
+
+    if (csat_start > 0 && RESET_POLARITY)
     {
-        polarity_copy[var] = polarity[var];
+        int n_vars = nVars();
+        for (int var = 0; var < n_vars; ++var)
+        {
+            polarity_copy[var] = polarity[var];
+        }
     }
-#endif
 }
-#endif
 
-#ifdef BACKPROP
 void Solver::countDistances()
 {
     int number_of_gates = csat_instance.get()->getNumberOfGates();
@@ -419,81 +536,295 @@ void Solver::countDistances()
             }
         }
     }
+
+    // The J-frontiers decide on representatives, at the least distance of their gates:
+    for (Var v = 0; v < nVars() && v < number_of_gates; v++)
+    {
+        Var r = var(representative[v]);
+        if (r != v && r < number_of_gates && distance_to_output[v] < distance_to_output[r])
+        {
+            distance_to_output[r] = distance_to_output[v];
+        }
+    }
+}
+
+// SCOAP controllabilities: the number of assignments (counting the gates on the way) needed to
+// set a gate to 0 or 1 from the circuit inputs, saturated at 'cc_max'. Computed in topological
+// order of the gates:
+//
+static const int cc_max = INT32_MAX / 4;
+static inline int ccAdd(int a, int b) { return a + b < cc_max ? a + b : cc_max; }
+
+void Solver::computeControllability()
+{
+    const csat::DAG &dag = *csat_instance;
+    int number_of_gates = dag.getNumberOfGates();
+    controllability[0].assign(number_of_gates, 1);
+    controllability[1].assign(number_of_gates, 1);
+    std::vector<int> &cc0 = controllability[0];
+    std::vector<int> &cc1 = controllability[1];
+
+    vec<int> pending(number_of_gates, 0);
+    vec<Var> order;
+    for (Var g = 0; g < number_of_gates; g++)
+    {
+        pending[g] = (int)dag.getGateOperands(g).size();
+        if (pending[g] == 0)
+        {
+            order.push(g);
+        }
+    }
+
+    for (int i = 0; i < order.size(); i++)
+    {
+        Var g = order[i];
+        const std::vector<size_t> &ops = dag.getGateOperands(g);
+        csat::GateType type = dag.getGateType(g);
+        if (ops.size() > 0)
+        {
+            // 'all' needs every operand at the non-controlling value, 'any' one at the controlling value:
+            int any0 = cc_max, all0 = 0, any1 = cc_max, all1 = 0;
+            int par0 = 0, par1 = cc_max; // Cheapest even and odd parity.
+            for (size_t op : ops)
+            {
+                any0 = std::min(any0, cc0[op]);
+                any1 = std::min(any1, cc1[op]);
+                all0 = ccAdd(all0, cc0[op]);
+                all1 = ccAdd(all1, cc1[op]);
+                int even = std::min(ccAdd(par0, cc0[op]), ccAdd(par1, cc1[op]));
+                int odd = std::min(ccAdd(par0, cc1[op]), ccAdd(par1, cc0[op]));
+                par0 = even;
+                par1 = odd;
+            }
+
+            switch (type)
+            {
+            case csat::GateType::AND:  cc0[g] = any0; cc1[g] = all1; break;
+            case csat::GateType::NAND: cc0[g] = all1; cc1[g] = any0; break;
+            case csat::GateType::OR:   cc0[g] = all0; cc1[g] = any1; break;
+            case csat::GateType::NOR:  cc0[g] = any1; cc1[g] = all0; break;
+            case csat::GateType::XOR:  cc0[g] = par0; cc1[g] = par1; break;
+            case csat::GateType::NXOR: cc0[g] = par1; cc1[g] = par0; break;
+            case csat::GateType::NOT:  cc0[g] = any1; cc1[g] = any0; break;
+            default:                   cc0[g] = any0; cc1[g] = any1; break;
+            }
+
+            cc0[g] = ccAdd(cc0[g], 1);
+            cc1[g] = ccAdd(cc1[g], 1);
+        }
+
+        for (size_t user : dag.getGateUsers(g))
+        {
+            if (--pending[user] == 0)
+            {
+                order.push(user);
+            }
+        }
+    }
+}
+
+// Gates with a controlling value (AND-like: 0, OR-like: 1) are justified by one operand at that
+// value when their output is the controlled one, all other gates by all of their operands:
+bool Solver::justified(Var gate)
+{
+    lbool val = value(representative[gate]);
+    csat::GateType type = csat_instance->getGateType(gate);
+    if (val == l_Undef || type == csat::GateType::INPUT)
+    {
+        return true;
+    }
+
+    bool and_like = type == csat::GateType::AND || type == csat::GateType::NAND;
+    bool or_like = type == csat::GateType::OR || type == csat::GateType::NOR;
+    bool inverted = type == csat::GateType::NAND || type == csat::GateType::NOR;
+    bool controlled = ((val == l_True) != inverted) == or_like;
+
+    bool all_assigned = true;
+    for (size_t operand : csat_instance->getGateOperands(gate))
+    {
+        lbool op_val = value(representative[operand]);
+        if (op_val == l_Undef)
+        {
+            all_assigned = false;
+        }
+        else if ((and_like || or_like) && controlled && (op_val == l_True) == or_like)
+        {
+            return true;
+        }
+    }
+
+    return all_assigned;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  pickBranchPodem : [void]  ->  [Lit]
+|
+|  Description:
+|    PODEM-style branching: the objective is the value of the unjustified J-frontier gate closest
+|    to the outputs. It is backtraced through unassigned operands to an unassigned circuit input:
+|    where one operand suffices, the easiest one to control is taken, where all operands are
+|    needed, the hardest one (to fail early). Substituted operands continue from their
+|    representatives. Returns the input with the value the objective requires, or 'lit_Undef' if
+|    all J-frontiers are justified or the backtrace ends elsewhere.
+|________________________________________________________________________________________________@*/
+Lit Solver::pickBranchPodem()
+{
+    const csat::DAG &dag = *csat_instance;
+    const std::vector<int> *cc = controllability;
+
+    // Objective:
+    Var gate = var_Undef;
+    int min_distance = INT32_MAX;
+    for (Var jFrontier : jFrontiers)
+    {
+        if (distance_to_output[jFrontier] < min_distance && !justified(jFrontier))
+        {
+            gate = jFrontier;
+            min_distance = distance_to_output[jFrontier];
+        }
+    }
+
+    if (gate == var_Undef)
+    {
+        return lit_Undef;
+    }
+
+    // Backtrace:
+    bool val = value(representative[gate]) == l_True;
+    int number_of_gates = dag.getNumberOfGates();
+    for (int steps = 0; steps < number_of_gates; steps++)
+    {
+        csat::GateType type = dag.getGateType(gate);
+        bool and_like = type == csat::GateType::AND || type == csat::GateType::NAND;
+        bool or_like = type == csat::GateType::OR || type == csat::GateType::NOR;
+        bool xor_like = type == csat::GateType::XOR || type == csat::GateType::NXOR;
+        bool inverted = type == csat::GateType::NAND || type == csat::GateType::NOR || type == csat::GateType::NXOR || type == csat::GateType::NOT;
+        bool out = val != inverted;
+
+        // The value required from the chosen operand, and whether to take the hardest one:
+        bool need = out, hardest = false;
+        if (and_like || or_like)
+        {
+            hardest = out != or_like;
+        }
+        else if (xor_like)
+        {
+            for (size_t operand : dag.getGateOperands(gate))
+            {
+                need = need != (value(representative[operand]) == l_True);
+            }
+        }
+
+        size_t next = SIZE_MAX;
+        int next_cost = 0;
+        for (size_t operand : dag.getGateOperands(gate))
+        {
+            if (value(representative[operand]) != l_Undef)
+            {
+                continue;
+            }
+
+            int cost = xor_like ? std::min(cc[0][operand], cc[1][operand]) : cc[need][operand];
+            if (next == SIZE_MAX || (hardest ? cost > next_cost : cost < next_cost))
+            {
+                next = operand;
+                next_cost = cost;
+            }
+        }
+
+        if (next == SIZE_MAX)
+        {
+            return lit_Undef;
+        }
+
+        Lit rep = representative[next];
+        gate = var(rep);
+        val = need != sign(rep);
+        if (gate >= number_of_gates || !decision[gate])
+        {
+            return lit_Undef;
+        }
+        else if (dag.getGateType(gate) == csat::GateType::INPUT)
+        {
+            return mkLit(gate, !val);
+        }
+    }
+
+    return lit_Undef;
+}
+
+// A gate that has become unassigned is no J-frontier, its assigned users are (substituted gates
+// have the value of their representative):
+void Solver::unassignJFrontier(Var x)
+{
+    jFrontiers.erase(x);
+
+    for (Var user : csat_instance.get()->getGateUsers(x))
+    {
+        if (value(representative[user]) != l_Undef)
+        {
+            jFrontiers.insert(user);
+        }
+    }
 }
-#endif
 
-#if defined BACKPROP && defined JFRONTIERS_ACTIVITY
-// ERROR
-#elif defined BACKPROP
+// Back propagation (see 'BackpropBranching'). J-frontiers without unassigned operands are dropped
+// on the way:
+template <class B>
 Var Solver::pickBranchjFParent()
 {
     vec<Var> to_delete;
     Var branch_jF_parent = var_Undef;
     int min_distance = 1000000000;
-#if COMPARE_BY_ACTIVITY
-    int max_activity = -1;
-#endif
-#if (PREFER_XOR && !AVOID_XOR) || (AVOID_XOR && !PREFER_XOR)
-    bool first_watch = true;
-#endif
+    double max_activity = -1;
+    bool branch_xor = false;
     for (Var jFrontier : jFrontiers)
     {
         bool real_jFrontier = false;
-        for (size_t jFParent : csat_instance.get()->getGateOperands(jFrontier))
+        for (size_t operand : csat_instance.get()->getGateOperands(jFrontier))
         {
-            if (assigns[jFParent] == l_Undef)
+            Var jFParent = var(representative[operand]);
+            if (assigns[jFParent] != l_Undef)
             {
-                real_jFrontier = true;
-                if (decision[jFParent])
-                {
-#if (PREFER_XOR && !AVOID_XOR) || (AVOID_XOR && !PREFER_XOR)
-                    csat::GateType gate_type = csat_instance.get()->getGateType(jFParent);
-                    csat::GateType branch_gate_type;
-                    if (!first_watch)
-                    {
-                        branch_gate_type = csat_instance.get()->getGateType(branch_jF_parent);
-                    }
+                continue;
+            }
 
-                    if (first_watch ||
-                        (PREFER_XOR && branch_gate_type != csat::GateType::XOR && branch_gate_type != csat::GateType::NXOR && (gate_type == csat::GateType::XOR || gate_type == csat::GateType::NXOR)) ||
-                        (AVOID_XOR && (branch_gate_type == csat::GateType::XOR || branch_gate_type == csat::GateType::NXOR) && gate_type != csat::GateType::XOR && gate_type != csat::GateType::NXOR))
-                    {
-                        branch_jF_parent = jFParent;
-                        min_distance = distance_to_output[jFParent];
-#if COMPARE_BY_ACTIVITY
-                        max_activity = activity[jFParent];
-#endif
-                        first_watch = false;
-                        continue;
-                    }
-#endif
-#if PREFER_XOR
-                    if ((gate_type != csat::GateType::XOR && gate_type != csat::GateType::NXOR) && (branch_gate_type == csat::GateType::XOR || branch_gate_type == csat::GateType::NXOR))
-#elif AVOID_XOR
-                    if ((gate_type == csat::GateType::XOR || gate_type == csat::GateType::NXOR) && (branch_gate_type != csat::GateType::XOR && branch_gate_type != csat::GateType::NXOR))
-#endif
-#if (PREFER_XOR && !AVOID_XOR) || (AVOID_XOR && !PREFER_XOR)
-                    {
-                        continue;
-                    }
-#endif
-                    if (distance_to_output[jFParent] < min_distance)
-                    {
-                        branch_jF_parent = jFParent;
-                        min_distance = distance_to_output[jFParent];
-#if COMPARE_BY_ACTIVITY
-                        max_activity = activity[jFParent];
-#endif
-                    }
-#if COMPARE_BY_ACTIVITY
-                    else if (distance_to_output[jFParent] == min_distance && activity[jFParent] > max_activity)
-                    {
-                        branch_jF_parent = jFParent;
-                        max_activity = activity[jFParent];
-                    }
-#endif
+            real_jFrontier = true;
+            if (!decision[jFParent])
+            {
+                continue;
+            }
+
+            if (B::xor_preference != xor_indifferent)
+            {
+                csat::GateType gate_type = csat_instance.get()->getGateType(jFParent);
+                bool is_xor = gate_type == csat::GateType::XOR || gate_type == csat::GateType::NXOR;
+                if (branch_jF_parent == var_Undef || (is_xor != branch_xor && is_xor == (B::xor_preference == xor_prefer)))
+                {
+                    branch_jF_parent = jFParent;
+                    min_distance = distance_to_output[jFParent];
+                    max_activity = activity[jFParent];
+                    branch_xor = is_xor;
+                    continue;
+                }
+                else if (is_xor != branch_xor)
+                {
+                    continue;
                 }
             }
+
+            if (distance_to_output[jFParent] < min_distance)
+            {
+                branch_jF_parent = jFParent;
+                min_distance = distance_to_output[jFParent];
+                max_activity = activity[jFParent];
+            }
+            else if (B::activity && distance_to_output[jFParent] == min_distance && activity[jFParent] > max_activity)
+            {
+                branch_jF_parent = jFParent;
+                max_activity = activity[jFParent];
+            }
         }
 
         if (!real_jFrontier)
@@ -509,8 +840,9 @@ Var Solver::pickBranchjFParent()
 
     return branch_jF_parent;
 }
-#elif defined JFRONTIERS_ACTIVITY
-Var Solver::pickBranchjFParent()
+
+template <>
+Var Solver::pickBranchjFParent<JFrontierActivityBranching>()
 {
     vec<Var> to_delete;
     Var branch_jF_parent = var_Undef;
@@ -518,8 +850,9 @@ Var Solver::pickBranchjFParent()
     for (Var jFrontier : jFrontiers)
     {
         bool real_jFrontier = false;
-        for (size_t jFParent : csat_instance.get()->getGateOperands(jFrontier))
+        for (size_t operand : csat_instance.get()->getGateOperands(jFrontier))
         {
+            Var jFParent = var(representative[operand]);
             if (assigns[jFParent] == l_Undef)
             {
                 real_jFrontier = true;
@@ -544,81 +877,59 @@ Var Solver::pickBranchjFParent()
 
     return branch_jF_parent;
 }
-#endif
-#ifdef CSAT_HEURISTIC_START
-Lit Solver::pickBranchLit()
+
+Var Solver::pickOrderVar()
 {
-    static bool reset = false;
     Var next = var_Undef;
-
-    if (starts <= DEFAULT_HEURISTIC_AFTER_N_RESTARTS)
-    {
-        next = pickBranchjFParent();
-    }
-    else
+    if (decision_order == 1)
     {
-        if (!reset)
-        {
-            int n_vars = nVars();
-#if RESET_ACTIVITY
-            for (int var = 0; var < n_vars; ++var)
-            {
-                activity[var] = rnd_init_act ? drand(random_seed) * 0.00001 : 0;
-            }
+        // All variables bumped more recently than the search position are assigned, so the walk
+        // towards less recently bumped variables can start there:
+        for (next = vmtf_queue.searchPos(); next != var_Undef && (value(next) != l_Undef || !decision[next]); next = vmtf_queue.prev(next))
+            ;
 
-            rebuildOrderHeap();
-#endif
-#if RESET_POLARITY && (defined POLARITY_INIT_MAXPROB || defined POLARITY_INIT_MAXBACKPROP)
-            for (int var = 0; var < n_vars; ++var)
-            {
-                polarity[var] = polarity_copy[var];
-            }
-#elif RESET_POLARITY
-            for (int var = 0; var < n_vars; ++var)
-            {
-                polarity[var] = DEFAULT_POLARITY_VALUE;
-            }
-#endif
-            reset = true;
-        }
+        vmtf_queue.setSearch(next);
+        return next;
+    }
 
-        while (next == var_Undef || value(next) != l_Undef || !decision[next])
+    while (next == var_Undef || value(next) != l_Undef || !decision[next])
+    {
+        if (order_heap.empty())
         {
-            if (order_heap.empty())
-            {
-                next = var_Undef;
-                break;
-            }
-            else
-            {
-                next = order_heap.removeMin();
-            }
+            return var_Undef;
         }
-    }
 
-    if (next == var_Undef)
-    {
-        return lit_Undef;
+        next = order_heap.removeMin();
     }
 
-    return mkLit(next, polarity[next]);
+    return next;
 }
-#elif defined BACKPROP || defined JFRONTIERS_ACTIVITY
+
+template <class B>
 Lit Solver::pickBranchLit()
 {
-    Var next = pickBranchjFParent();
+    Var next = var_Undef;
 
-    if (next == var_Undef)
+    if constexpr (B::circuit)
     {
-        return lit_Undef;
-    }
+        if (B::kind == branch_backprop && podem)
+        {
+            Lit p = pickBranchPodem();
+            if (p != lit_Undef)
+            {
+                podem_decisions++;
+                return p;
+            }
+        }
 
-    return mkLit(next, polarity[next]);
-}
-#else
-Lit Solver::pickBranchLit()
-{
-    Var next = var_Undef;
+        next = pickBranchjFParent<B>();
+        if (next == var_Undef)
+        {
+            return lit_Undef;
+        }
+
+        return mkLit(next, branchPolarity(next));
+    }
 
     // Random decision (default: false):
     if (drand(random_seed) < random_var_freq && !order_heap.empty())
@@ -630,18 +941,10 @@ Lit Solver::pickBranchLit()
         }
     }
 
-    // Activity based decision:
-    while (next == var_Undef || value(next) != l_Undef || !decision[next])
+    // Activity (or VMTF) based decision:
+    if (next == var_Undef || value(next) != l_Undef || !decision[next])
     {
-        if (order_heap.empty())
-        {
-            next = var_Undef;
-            break;
-        }
-        else
-        {
-            next = order_heap.removeMin();
-        }
+        next = pickOrderVar();
     }
 
     // Choose polarity based on different polarity modes (global or per-variable):
@@ -658,21 +961,126 @@ Lit Solver::pickBranchLit()
         return mkLit(next, drand(random_seed) < 0.5);
     }
 
-    return mkLit(next, polarity[next]);
+    return mkLit(next, branchPolarity(next));
 }
-#endif
 
-/*_________________________________________________________________________________________________
-|
-|  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
-|
-|  Description:
-|    Analyze conflict and produce a reason clause.
-|
-|    Pre-conditions:
-|      * 'out_learnt' is assumed to be cleared.
-|      * Current decision level must be greater than root level.
-|
+// The circuit heuristic of the first 'csat_start' restarts gives way to the decision order, which
+// starts over from reset activities and polarities (see Config.h):
+//
+void Solver::endCircuitStart()
+{
+    int n_vars = nVars();
+    if (RESET_ACTIVITY)
+    {
+        for (int var = 0; var < n_vars; ++var)
+        {
+            activity[var] = rnd_init_act ? drand(random_seed) * 0.00001 : 0;
+        }
+
+        rebuildOrderHeap();
+    }
+
+    if (RESET_POLARITY)
+    {
+        for (int var = 0; var < n_vars; ++var)
+        {
+            polarity[var] = polarity_init != polarity_default ? polarity_copy[var] : DEFAULT_POLARITY_VALUE;
+        }
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  findConflictLevel : (confl : CRef) (single : bool&)  ->  [int]
+|
+|  Description:
+|    Used with chronological backtracking, where the literals of a conflicting clause may all be
+|    below the current decision level. Returns the highest level in the clause and moves the two
+|    literals with the highest levels to 'c[0]' and 'c[1]' (updating the watches), so that the
+|    clause is watched correctly after backtracking below them. 'single' is set if only 'c[0]' has
+|    the highest level, in which case the clause becomes unit after backtracking one level below
+|    it, asserting 'c[0]' at the level of 'c[1]'.
+|________________________________________________________________________________________________@*/
+int Solver::findConflictLevel(CRef confl, bool &single)
+{
+    Clause &c = ca[confl];
+    single = false;
+    if (level(var(c[0])) == decisionLevel() && level(var(c[1])) == decisionLevel())
+    {
+        return decisionLevel();
+    }
+
+    int i0 = 0, i1 = 1;
+    if (level(var(c[1])) > level(var(c[0])))
+    {
+        i0 = 1, i1 = 0;
+    }
+
+    for (int i = 2; i < c.size(); i++)
+    {
+        int l = level(var(c[i]));
+        if (l > level(var(c[i0])))
+        {
+            i1 = i0;
+            i0 = i;
+        }
+        else if (l > level(var(c[i1])))
+        {
+            i1 = i;
+        }
+    }
+
+    int highest = level(var(c[i0]));
+    single = level(var(c[i1])) < highest;
+
+    Lit w0 = c[0], w1 = c[1];
+    Lit q = c[0];
+    c[0] = c[i0];
+    c[i0] = q;
+    if (i1 == 0)
+    {
+        i1 = i0;
+    }
+
+    q = c[1];
+    c[1] = c[i1];
+    c[i1] = q;
+
+    // Move the watches of the literals that are no longer watched:
+    if (w0 != c[0] && w0 != c[1])
+    {
+        remove(watches[~w0], Watcher(confl, w1));
+    }
+
+    if (w1 != c[0] && w1 != c[1])
+    {
+        remove(watches[~w1], Watcher(confl, w0));
+    }
+
+    if (c[0] != w0 && c[0] != w1)
+    {
+        watches[~c[0]].push(Watcher(confl, c[1]));
+    }
+
+    if (c[1] != w0 && c[1] != w1)
+    {
+        watches[~c[1]].push(Watcher(confl, c[0]));
+    }
+
+    return highest;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  analyze : (confl : Clause*) (out_learnt : vec<Lit>&) (out_btlevel : int&)  ->  [void]
+|
+|  Description:
+|    Analyze conflict and produce a reason clause.
+|
+|    Pre-conditions:
+|      * 'out_learnt' is assumed to be cleared.
+|      * Current decision level must be greater than root level.
+|
 |    Post-conditions:
 |      * 'out_learnt[0]' is the asserting literal at level 'out_btlevel'.
 |      * If out_learnt.size() > 1 then 'out_learnt[1]' has the greatest decision level of the
@@ -684,6 +1092,10 @@ void Solver::analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel)
     int pathC = 0;
     Lit p = lit_Undef;
 
+    // With chronological backtracking the conflict may be below the current decision level (see
+    // 'findConflictLevel()', which puts a literal of the conflict level first):
+    int conflict_level = chrono >= 0 ? level(var(ca[confl][0])) : decisionLevel();
+
     // Generate conflict clause:
     //
     out_learnt.push(); // (leave room for the asserting literal)
@@ -697,6 +1109,11 @@ void Solver::analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel)
         if (c.learnt())
         {
             claBumpActivity(c);
+            if (c.imported())
+            {
+                c.imported(false);
+                shared_useful++;
+            }
         }
 
         for (int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++)
@@ -707,7 +1124,7 @@ void Solver::analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel)
             {
                 varBumpActivity(var(q));
                 seen[var(q)] = 1;
-                if (level(var(q)) >= decisionLevel())
+                if (level(var(q)) >= conflict_level)
                 {
                     pathC++;
                 }
@@ -718,9 +1135,12 @@ void Solver::analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel)
             }
         }
         // Select next clause to look at:
-        while (!seen[var(trail[index--])])
-            ;
-        p = trail[index + 1];
+        do
+        {
+            while (!seen[var(trail[index--])])
+                ;
+            p = trail[index + 1];
+        } while (level(var(p)) < conflict_level);
         confl = reason(var(p));
         seen[var(p)] = 0;
         pathC--;
@@ -771,6 +1191,11 @@ void Solver::analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel)
 
     max_literals += out_learnt.size();
     out_learnt.shrink(i - j);
+    if (bin_min_glue > 0 && out_learnt.size() > 2 && out_learnt.size() <= bin_min_max_size && computeLBD(out_learnt) <= bin_min_glue)
+    {
+        binaryMinimize(out_learnt);
+    }
+
     tot_literals += out_learnt.size();
 
     // Find correct backtrack level:
@@ -801,6 +1226,36 @@ void Solver::analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel)
     {
         seen[var(analyze_toclear[j])] = 0; // ('seen[]' is now cleared)
     }
+
+    if (decision_order == 1)
+    {
+        vmtfBumpVars();
+    }
+}
+
+struct VmtfStampLt
+{
+    const VmtfQueue<Var> &queue;
+    VmtfStampLt(const VmtfQueue<Var> &q) : queue(q) {}
+    bool operator()(Var x, Var y) const { return queue.stamp(x) < queue.stamp(y); }
+};
+
+// Moves the variables bumped during conflict analysis to the front of the VMTF queue. They are
+// moved in the order of their previous stamps, so their relative order is kept.
+void Solver::vmtfBumpVars()
+{
+    sort(vmtf_bumped, VmtfStampLt(vmtf_queue));
+    for (int i = 0; i < vmtf_bumped.size(); i++)
+    {
+        Var v = vmtf_bumped[i];
+        vmtf_queue.moveToFront(v);
+        if (value(v) == l_Undef && decision[v])
+        {
+            vmtf_queue.updateSearch(v);
+        }
+    }
+
+    vmtf_bumped.clear();
 }
 
 // Check if 'p' can be removed from a conflict clause.
@@ -880,6 +1335,70 @@ bool Solver::litRedundant(Lit p)
     return true;
 }
 
+int Solver::computeLBD(const vec<Lit> &lits)
+{
+    uint32_t s = nextStamp();
+    int lbd = 0;
+    for (int i = 0; i < lits.size(); i++)
+    {
+        int l = level(var(lits[i]));
+        if (level_stamp[l] != s)
+        {
+            level_stamp[l] = s;
+            lbd++;
+        }
+    }
+
+    return lbd;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  binaryMinimize : (out_learnt : vec<Lit>&)  ->  [void]
+|
+|  Description:
+|    Removes the literals 'l' of a learnt clause for which a binary clause '(out_learnt[0] | ~l)'
+|    exists: resolving on it yields the clause without 'l'. The literals are stamped, so that one
+|    pass over the watches of '~out_learnt[0]' suffices. Only binary clauses are dereferenced; they
+|    are recognized by their blocker, which is always the other literal.
+|________________________________________________________________________________________________@*/
+void Solver::binaryMinimize(vec<Lit> &out_learnt)
+{
+    uint32_t s = nextStamp();
+    for (int i = 1; i < out_learnt.size(); i++)
+    {
+        var_stamp[var(out_learnt[i])] = s;
+    }
+
+    // Since the learnt literals are false, a true blocker on a stamped variable is their negation:
+    int removed = 0;
+    vec<Watcher> &ws = watches.lookup(~out_learnt[0]);
+    for (int k = 0; k < ws.size(); k++)
+    {
+        Lit imp = ws[k].blocker;
+        if (var_stamp[var(imp)] == s && value(imp) == l_True && ca[ws[k].cref].size() == 2)
+        {
+            var_stamp[var(imp)] = s - 1;
+            removed++;
+        }
+    }
+
+    if (removed > 0)
+    {
+        int i, j;
+        for (i = j = 1; i < out_learnt.size(); i++)
+        {
+            if (var_stamp[var(out_learnt[i])] == s)
+            {
+                out_learnt[j++] = out_learnt[i];
+            }
+        }
+
+        out_learnt.shrink(i - j);
+        bin_min_literals += removed;
+    }
+}
+
 /*_________________________________________________________________________________________________
 |
 |  analyzeFinal : (p : Lit)  ->  [void]
@@ -930,16 +1449,21 @@ void Solver::analyzeFinal(Lit p, LSet &out_conflict)
     seen[var(p)] = 0;
 }
 
-void Solver::uncheckedEnqueue(Lit p, CRef from)
+void Solver::uncheckedEnqueue(Lit p, int level, CRef from)
 {
     assert(value(p) == l_Undef);
     assigns[var(p)] = lbool(!sign(p));
-    vardata[var(p)] = mkVarData(from, decisionLevel());
+    vardata[var(p)] = mkVarData(from, level);
     trail.push_(p);
 
-#if defined BACKPROP || defined JFRONTIERS_ACTIVITY
-    jFrontiers.insert(var(p));
-#endif
+    if (branching != branch_order)
+    {
+        jFrontiers.insert(var(p));
+        for (int i = 0; var(p) < substituted.size() && i < substituted[var(p)].size(); i++)
+        {
+            jFrontiers.insert(substituted[var(p)][i]);
+        }
+    }
 }
 
 /*_________________________________________________________________________________________________
@@ -961,6 +1485,7 @@ CRef Solver::propagate()
     while (qhead < trail.size())
     {
         Lit p = trail[qhead++]; // 'p' is enqueued fact to propagate.
+        int p_level = level(var(p));
         vec<Watcher> &ws = watches.lookup(p);
         Watcher *i, *j, *end;
         num_props++;
@@ -997,6 +1522,21 @@ CRef Solver::propagate()
             }
 
             // Look for new watch:
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(PACKED_VAR_STATE)
+            if (simd_watch_search && c.size() >= simd_min_size)
+            {
+                assert((assigns.end() - assigns.begin()) % 4 == 0);
+                int k = firstNonFalseAVX2((const Lit *)c, 2, c.size(), (const uint8_t *)&assigns[0]);
+                if (k < c.size())
+                {
+                    c[1] = c[k];
+                    c[k] = false_lit;
+                    watches[~c[1]].push(w);
+                    goto NextClause;
+                }
+            }
+            else
+#endif
             for (int k = 2; k < c.size(); k++)
             {
                 if (value(c[k]) != l_False)
@@ -1020,10 +1560,33 @@ CRef Solver::propagate()
                     *j++ = *i++;
                 }
             }
-            else
+            else if (p_level == decisionLevel())
             {
                 uncheckedEnqueue(first, cr);
             }
+            else
+            {
+                // Out-of-order propagation (after chronological backtracking): 'first' is implied at
+                // the highest level of the other literals, and that literal has to be watched:
+                int max_k = 1;
+                for (int k = 2; k < c.size(); k++)
+                {
+                    if (level(var(c[k])) > level(var(c[max_k])))
+                    {
+                        max_k = k;
+                    }
+                }
+
+                if (max_k != 1)
+                {
+                    c[1] = c[max_k];
+                    c[max_k] = false_lit;
+                    j--;
+                    watches[~c[1]].push(w);
+                }
+
+                uncheckedEnqueue(first, level(var(c[1])), cr);
+            }
 
         NextClause:;
         }
@@ -1042,40 +1605,62 @@ CRef Solver::propagate()
 |  Description:
 |    Remove half of the learnt clauses, minus the clauses locked by the current assignment. Locked
 |    clauses are clauses that are reason to some assignment. Binary clauses are never removed.
+|    The least active clauses are found by selection on keys copied out of the clause arena, and
+|    the surviving clauses keep their order in 'learnts'.
 |________________________________________________________________________________________________@*/
-struct reduceDB_lt
-{
-    ClauseAllocator &ca;
-    reduceDB_lt(ClauseAllocator &ca_) : ca(ca_) {}
-    bool operator()(CRef x, CRef y)
-    {
-        return ca[x].size() > 2 && (ca[y].size() == 2 || ca[x].activity() < ca[y].activity());
-    }
-};
-
 void Solver::reduceDB()
 {
+    double start_time = verbosity >= 2 ? cpuTime() : 0;
     int i, j;
+    int half = learnts.size() / 2;
     double extra_lim = cla_inc / learnts.size(); // Remove any clause below this activity
 
-    sort(learnts, reduceDB_lt(ca));
+    // In activity order, binary clauses would come after all others:
+    reduce_keys.clear();
+    for (i = 0; i < learnts.size(); i++)
+    {
+        Clause &c = ca[learnts[i]];
+        if (c.size() > 2)
+        {
+            ReduceDBKey k = {c.activity(), learnts[i]};
+            reduce_keys.push(k);
+        }
+    }
+
+    int n_keys = reduce_keys.size();
+    if (half < n_keys)
+    {
+        std::nth_element((ReduceDBKey *)reduce_keys, (ReduceDBKey *)reduce_keys + half, (ReduceDBKey *)reduce_keys + n_keys);
+    }
+
     // Don't delete binary or locked clauses. From the rest, delete clauses from the first half
     // and clauses with activity smaller than 'extra_lim':
-    for (i = j = 0; i < learnts.size(); i++)
+    for (i = 0; i < n_keys; i++)
     {
-        Clause &c = ca[learnts[i]];
-        if (c.size() > 2 && !locked(c) && (i < learnts.size() / 2 || c.activity() < extra_lim))
+        Clause &c = ca[reduce_keys[i].cref];
+        if (!locked(c) && (i < half || c.activity() < extra_lim))
         {
-            removeClause(learnts[i]);
+            removeClause(reduce_keys[i].cref);
         }
-        else
+    }
+
+    for (i = j = 0; i < learnts.size(); i++)
+    {
+        if (!isRemoved(learnts[i]))
         {
             learnts[j++] = learnts[i];
         }
     }
 
+    int removed = i - j;
     learnts.shrink(i - j);
     checkGarbage();
+
+    if (verbosity >= 2)
+    {
+        printf("|  Reduce DB: %10d of %10d learnts removed in %9.3f ms         |\n",
+               removed, removed + learnts.size(), (cpuTime() - start_time) * 1000);
+    }
 }
 
 void Solver::removeSatisfied(vec<CRef> &cs)
@@ -1110,6 +1695,13 @@ void Solver::removeSatisfied(vec<CRef> &cs)
 
 void Solver::rebuildOrderHeap()
 {
+    if (decision_order == 1)
+    {
+        // The VMTF queue keeps all variables, only the search position has to be reset:
+        vmtf_queue.setSearch(vmtf_queue.last());
+        return;
+    }
+
     vec<Var> vs;
     for (Var v = 0; v < nVars(); v++)
     {
@@ -1191,55 +1783,1348 @@ bool Solver::simplify()
     return true;
 }
 
+void Solver::addTechnique(const char *name, bool (Solver::*run)(int64_t), bool enabled)
+{
+    Technique t = {name, run, enabled, 0, 0, 0, 0};
+    techniques.push(t);
+}
+
 /*_________________________________________________________________________________________________
 |
-|  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
+|  inprocess : [void]  ->  [bool]
 |
 |  Description:
-|    Search for a model the specified number of conflicts.
-|    NOTE! Use negative value for 'nof_conflicts' indicate infinity.
-|
-|  Output:
-|    'l_True' if a partial assigment that is consistent with respect to the clauseset is found. If
-|    all variables are decision variables, this means that the clause set is satisfiable. 'l_False'
-|    if the clause set is unsatisfiable. 'l_Undef' if the bound on number of conflicts is reached.
+|    Runs the enabled inprocessing techniques one after another at decision level 0. Each gets a
+|    budget of 'inprocess_effort' times the propagations made by the search since the last round.
+|    Phase saving is disabled meanwhile, so that the techniques' own decisions do not overwrite the
+|    saved phases. Afterwards the watches, the decision order and the J-frontiers are rebuilt from
+|    the remaining clauses and assignments. Returns FALSE if the clauses became unsatisfiable.
 |________________________________________________________________________________________________@*/
-lbool Solver::search(int nof_conflicts)
+bool Solver::inprocess()
 {
-    assert(ok);
-    int backtrack_level;
-    int conflictC = 0;
-    vec<Lit> learnt_clause;
-    starts++;
+    assert(decisionLevel() == 0);
+    inprocessings++;
+    next_inprocess = conflicts + inprocess_int * (inprocessings + 1);
+    int64_t budget = (int64_t)((propagations - inprocess_props) * inprocess_effort);
 
-    for (;;)
+    int saved_phase_saving = phase_saving;
+    phase_saving = 0;
+    for (int i = 0; i < techniques.size() && ok; i++)
     {
-        CRef confl = propagate();
-        if (confl != CRef_Undef)
+        Technique &t = techniques[i];
+        if (!t.enabled)
         {
-            // CONFLICT
-            conflicts++;
-            conflictC++;
-            if (decisionLevel() == 0)
-            {
-                return l_False;
-            }
+            continue;
+        }
 
-            learnt_clause.clear();
-            analyze(confl, learnt_clause, backtrack_level);
-            cancelUntil(backtrack_level);
+        double start_time = cpuTime();
+        int64_t clauses_before = num_clauses + num_learnts;
+        int64_t literals_before = clauses_literals + learnts_literals;
 
-            if (learnt_clause.size() == 1)
+        if (!(this->*t.run)(budget))
+        {
+            ok = false;
+        }
+
+        t.calls++;
+        t.time += cpuTime() - start_time;
+        t.clauses_removed += clauses_before - (int64_t)(num_clauses + num_learnts);
+        t.literals_removed += literals_before - (int64_t)(clauses_literals + learnts_literals);
+
+        if (verbosity >= 2)
+        {
+            printf("| %-12s %8" PRId64 " clauses %10" PRId64 " literals removed %9.2f s       |\n",
+                   t.name, clauses_before - (int64_t)(num_clauses + num_learnts),
+                   literals_before - (int64_t)(clauses_literals + learnts_literals), cpuTime() - start_time);
+        }
+    }
+
+    phase_saving = saved_phase_saving;
+    if (!ok)
+    {
+        return false;
+    }
+
+    watches.cleanAll();
+
+    // Every assigned gate is a J-frontier candidate, the stale ones are dropped on demand:
+    jFrontiers.clear();
+    for (int i = 0; i < trail.size() && branching != branch_order; i++)
+    {
+        Var x = var(trail[i]);
+        jFrontiers.insert(x);
+        for (int k = 0; x < substituted.size() && k < substituted[x].size(); k++)
+        {
+            jFrontiers.insert(substituted[x][k]);
+        }
+    }
+
+    inprocess_props = propagations;
+
+    // Force a full 'simplify()', which also rebuilds the decision order and collects garbage:
+    simpDB_assigns = -1;
+    simpDB_props = 0;
+    return simplify();
+}
+
+/*_________________________________________________________________________________________________
+|
+|  probe : (budget : int64_t)  ->  [bool]
+|
+|  Description:
+|    Failed-literal probing at level 0, until 'budget' propagations are spent. The candidates are the
+|    roots of the binary implication graph (literals with binary implications but no binary clause
+|    implying them) and the gates with at least 'probe_min_fanout' users. Both phases of a candidate
+|    are propagated: a phase that fails gives the opposite unit, and the literals implied by both
+|    phases are units as well. The literals implied by a root form a tree, where the parent of a
+|    literal implied through a longer clause is the dominator of its antecedents (their nearest
+|    common ancestor). Such a literal learns the hyper-binary resolvent '(~dominator | implied)',
+|    which skips the implications the tree already has, up to 'probe_max_hbrs' per pass. Returns
+|    FALSE if the clauses were found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::probe(int64_t budget)
+{
+    assert(decisionLevel() == 0);
+    uint64_t props_limit = propagations + budget;
+
+    // Binary in-degree of each literal (the binary clauses containing it) and out-degree (of its negation):
+    vec<int> in_degree(2 * nVars(), 0), out_degree(2 * nVars(), 0);
+    for (int i = 0; i < 2 * nVars(); i++)
+    {
+        Lit p = toLit(i);
+        const vec<Watcher> &ws = watches.lookup(p);
+        for (int k = 0; k < ws.size(); k++)
+        {
+            if (ca[ws[k].cref].size() == 2)
             {
-                uncheckedEnqueue(learnt_clause[0]);
+                out_degree[i]++;
+                in_degree[toInt(ws[k].blocker)]++;
             }
-            else
+        }
+    }
+
+    vec<Var> candidates;
+    uint32_t s = nextStamp();
+    for (int i = 0; i < 2 * nVars(); i++)
+    {
+        Var v = var(toLit(i));
+        if (in_degree[i] == 0 && out_degree[i] > 0 && decision[v] && value(v) == l_Undef)
+        {
+            if (var_stamp[v] != s)
             {
-                CRef cr = ca.alloc(learnt_clause, true);
-                learnts.push(cr);
-                attachClause(cr);
-                claBumpActivity(ca[cr]);
-                uncheckedEnqueue(learnt_clause[0], cr);
+                var_stamp[v] = s;
+                candidates.push(v);
+            }
+        }
+    }
+
+    if (csat_instance)
+    {
+        for (Var v = 0; v < nVars() && v < (Var)csat_instance.get()->getNumberOfGates(); v++)
+        {
+            if (var_stamp[v] != s && decision[v] && value(v) == l_Undef &&
+                (int)csat_instance.get()->getGateUsers(v).size() >= probe_min_fanout)
+            {
+                var_stamp[v] = s;
+                candidates.push(v);
+            }
+        }
+    }
+
+    // 'seen' holds '1 + sign' of the literals implied by the first phase. 'parent' and 'depth' give
+    // the binary implication tree of the literals implied by a root:
+    vec<Lit> implied, units, hbr;
+    vec<Lit> parent(nVars(), lit_Undef);
+    vec<int> depth(nVars(), 0);
+    int hbrs = 0;
+    for (int i = 0; i < candidates.size() && propagations < props_limit && ok; i++)
+    {
+        Var v = candidates[i];
+        if (value(v) != l_Undef)
+        {
+            continue;
+        }
+
+        units.clear();
+        implied.clear();
+        for (int phase = 0; phase < 2; phase++)
+        {
+            Lit p = mkLit(v, phase == 1);
+            bool root = in_degree[toInt(p)] == 0 && out_degree[toInt(p)] > 0 && hbrs < probe_max_hbrs;
+
+            newDecisionLevel();
+            uncheckedEnqueue(p);
+            if (propagate() != CRef_Undef)
+            {
+                cancelUntil(0);
+                units.clear();
+                units.push(~p);
+                break;
+            }
+
+            hbr.clear();
+            parent[v] = lit_Undef;
+            depth[v] = 0;
+            for (int k = trail_lim[0] + 1; k < trail.size(); k++)
+            {
+                Lit x = trail[k];
+                if (phase == 0)
+                {
+                    seen[var(x)] = 1 + sign(x);
+                    implied.push(x);
+                }
+                else if (seen[var(x)] == 1 + sign(x))
+                {
+                    units.push(x);
+                }
+
+                if (root)
+                {
+                    // Find the dominator of the antecedents at level 1. A literal implied by a
+                    // single one of them (a binary clause in effect) needs no resolvent:
+                    const Clause &c = ca[reason(var(x))];
+                    Lit d = lit_Undef;
+                    int antecedents = 0;
+                    for (int j = 0; j < c.size(); j++)
+                    {
+                        Lit y = ~c[j];
+                        if (c[j] == x || level(var(y)) == 0)
+                        {
+                            continue;
+                        }
+
+                        antecedents++;
+                        if (d == lit_Undef)
+                        {
+                            d = y;
+                            continue;
+                        }
+
+                        while (d != y)
+                        {
+                            if (depth[var(d)] < depth[var(y)])
+                            {
+                                y = parent[var(y)];
+                            }
+                            else
+                            {
+                                d = parent[var(d)];
+                            }
+                        }
+                    }
+
+                    parent[var(x)] = d;
+                    depth[var(x)] = depth[var(d)] + 1;
+                    if (antecedents > 1 && hbrs < probe_max_hbrs)
+                    {
+                        hbr.push(~d);
+                        hbr.push(x);
+                        hbrs++;
+                    }
+                }
+            }
+
+            cancelUntil(0);
+
+            for (int k = 0; k < hbr.size(); k += 2)
+            {
+                add_tmp.clear();
+                add_tmp.push(hbr[k + 1]);
+                add_tmp.push(hbr[k]);
+                CRef cr = ca.alloc(add_tmp, true);
+                learnts.push(cr);
+                attachClause(cr);
+                probe_hbrs++;
+            }
+        }
+
+        for (int k = 0; k < implied.size(); k++)
+        {
+            seen[var(implied[k])] = 0;
+        }
+
+        for (int k = 0; k < units.size(); k++)
+        {
+            if (value(units[k]) == l_Undef)
+            {
+                probe_units++;
+                uncheckedEnqueue(units[k]);
+                if (propagate() != CRef_Undef)
+                {
+                    return ok = false;
+                }
+            }
+            else if (value(units[k]) == l_False)
+            {
+                return ok = false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  substituteEquivalences : (budget : int64_t)  ->  [bool]
+|
+|  Description:
+|    Finds the strongly connected components of the binary implication graph (with Tarjan's
+|    algorithm, iteratively) among the unassigned literals. The literals of a component are
+|    equivalent: each variable is substituted by the literal of the component's smallest (frozen, if
+|    any) variable in all clauses, and becomes a non-decision variable. Frozen variables are kept.
+|    The J-frontiers and distances treat a substituted gate like its representative, 'extendModel()'
+|    assigns it from the representative. The watches are rebuilt from scratch. The pass is linear,
+|    so the budget is not used. Returns FALSE if a variable is equivalent to its negation or the
+|    clauses became unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::substituteEquivalences(int64_t)
+{
+    assert(decisionLevel() == 0);
+    watches.cleanAll();
+
+    int n = 2 * nVars();
+    vec<int> index(n, -1), lowlink(n, 0);
+    vec<char> on_stack(n, 0);
+    vec<Lit> stack, component;
+    vec<Var> subst;
+    vec<SccFrame> frames;
+    int counter = 0;
+
+    for (int i = 0; i < n; i++)
+    {
+        Lit root = toLit(i);
+        if (index[i] != -1 || value(root) != l_Undef || eliminated[var(root)])
+        {
+            continue;
+        }
+
+        index[i] = lowlink[i] = counter++;
+        stack.push(root);
+        on_stack[i] = 1;
+        frames.push(SccFrame(root));
+
+        while (frames.size() > 0)
+        {
+            Lit p = frames.last().lit;
+            const vec<Watcher> &ws = watches[p];
+            if (frames.last().pos < ws.size())
+            {
+                const Watcher &w = ws[frames.last().pos++];
+                Lit q = w.blocker;
+                if (value(q) != l_Undef || ca[w.cref].size() != 2)
+                {
+                    continue;
+                }
+
+                if (index[toInt(q)] == -1)
+                {
+                    index[toInt(q)] = lowlink[toInt(q)] = counter++;
+                    stack.push(q);
+                    on_stack[toInt(q)] = 1;
+                    frames.push(SccFrame(q));
+                }
+                else if (on_stack[toInt(q)] && index[toInt(q)] < lowlink[toInt(p)])
+                {
+                    lowlink[toInt(p)] = index[toInt(q)];
+                }
+
+                continue;
+            }
+
+            frames.pop();
+            if (frames.size() > 0 && lowlink[toInt(p)] < lowlink[toInt(frames.last().lit)])
+            {
+                lowlink[toInt(frames.last().lit)] = lowlink[toInt(p)];
+            }
+
+            if (lowlink[toInt(p)] != index[toInt(p)])
+            {
+                continue;
+            }
+
+            // 'p' is the root of a component:
+            component.clear();
+            Lit q;
+            do
+            {
+                q = stack.last();
+                stack.pop();
+                on_stack[toInt(q)] = 0;
+                component.push(q);
+            } while (q != p);
+
+            if (component.size() == 1)
+            {
+                continue;
+            }
+
+            Lit repr = component[0];
+            uint32_t s = nextStamp();
+            for (int k = 0; k < component.size(); k++)
+            {
+                if (var_stamp[var(component[k])] == s)
+                {
+                    return ok = false; // Both polarities of a variable are equivalent.
+                }
+
+                var_stamp[var(component[k])] = s;
+                Var v = var(component[k]), r = var(repr);
+                if (frozen[v] != frozen[r] ? frozen[v] : v < r)
+                {
+                    repr = component[k];
+                }
+            }
+
+            // The dual component gives the same substitutions, only the first one is recorded:
+            for (int k = 0; k < component.size(); k++)
+            {
+                Var v = var(component[k]);
+                if (v != var(repr) && !frozen[v] && representative[v] == mkLit(v))
+                {
+                    representative[v] = repr ^ sign(component[k]);
+                    subst.push(v);
+                }
+            }
+        }
+    }
+
+    if (subst.size() == 0)
+    {
+        return true;
+    }
+
+    // Representatives are never substituted themselves, so the earlier substitutions can be
+    // resolved to the new representatives:
+    substituted.growTo(nVars());
+    for (int i = 0; i < subst.size(); i++)
+    {
+        Var v = subst[i];
+        Var r = var(representative[v]);
+        for (int k = 0; k < substituted[v].size(); k++)
+        {
+            Var m = substituted[v][k];
+            representative[m] = representative[v] ^ sign(representative[m]);
+            substituted[r].push(m);
+        }
+
+        substituted[v].clear(true);
+        substituted[r].push(v);
+        setDecisionVar(v, false);
+        substituted_vars++;
+    }
+
+    // The reasons of level 0 are never used by the conflict analysis, and their clauses may change:
+    for (int i = 0; i < trail.size(); i++)
+    {
+        vardata[var(trail[i])].reason = CRef_Undef;
+    }
+
+    for (int i = 0; i < n; i++)
+    {
+        watches[toLit(i)].clear();
+    }
+
+    num_clauses = num_learnts = clauses_literals = learnts_literals = 0;
+
+    // Substitute in all clauses, and attach them again:
+    vec<Lit> units;
+    for (int k = 0; k < 2; k++)
+    {
+        vec<CRef> &cs = k == 0 ? clauses : learnts;
+        int i, j;
+        for (i = j = 0; i < cs.size(); i++)
+        {
+            Clause &c = ca[cs[i]];
+            if (c.mark() != 0)
+            {
+                continue;
+            }
+
+            add_tmp.clear();
+            for (int l = 0; l < c.size(); l++)
+            {
+                add_tmp.push(representative[var(c[l])] ^ sign(c[l]));
+            }
+
+            sort(add_tmp);
+            Lit prev = lit_Undef;
+            bool skip = false;
+            int a, b;
+            for (a = b = 0; a < add_tmp.size() && !skip; a++)
+            {
+                if (value(add_tmp[a]) == l_True || add_tmp[a] == ~prev)
+                {
+                    skip = true;
+                }
+                else if (value(add_tmp[a]) != l_False && add_tmp[a] != prev)
+                {
+                    add_tmp[b++] = prev = add_tmp[a];
+                }
+            }
+
+            add_tmp.shrink(a - b);
+            if (skip || add_tmp.size() <= 1)
+            {
+                if (!skip && add_tmp.size() == 0)
+                {
+                    ok = false;
+                }
+                else if (!skip)
+                {
+                    units.push(add_tmp[0]);
+                }
+
+                c.mark(1);
+                ca.free(cs[i]);
+                continue;
+            }
+
+            for (int l = 0; l < add_tmp.size(); l++)
+            {
+                c[l] = add_tmp[l];
+            }
+
+            c.shrink(c.size() - add_tmp.size());
+            attachClause(cs[i]);
+            cs[j++] = cs[i];
+        }
+
+        cs.shrink(i - j);
+    }
+
+    for (int i = 0; i < units.size() && ok; i++)
+    {
+        if (value(units[i]) == l_False)
+        {
+            ok = false;
+        }
+        else if (value(units[i]) == l_Undef)
+        {
+            uncheckedEnqueue(units[i]);
+        }
+    }
+
+    if (ok && propagate() != CRef_Undef)
+    {
+        ok = false;
+    }
+
+    if (branching == branch_backprop)
+    {
+        countDistances();
+    }
+
+    checkGarbage();
+    return ok;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  vivifyLearnts : (budget : int64_t)  ->  [bool]
+|
+|  Description:
+|    Shortens learnt clauses, most active first, until 'budget' propagations are spent. A clause is
+|    detached and the negations of its literals are decided one by one: literals that propagation
+|    already made false are dropped, and the clause is cut after a literal that became true or after
+|    a decision that led to a conflict. Clauses that are reasons of the (level 0) trail are skipped.
+|________________________________________________________________________________________________@*/
+bool Solver::vivifyLearnts(int64_t budget)
+{
+    assert(decisionLevel() == 0);
+    uint64_t props_limit = propagations + budget;
+
+    reduce_keys.clear();
+    for (int i = 0; i < learnts.size(); i++)
+    {
+        Clause &c = ca[learnts[i]];
+        if (c.size() > 2 && !locked(c))
+        {
+            ReduceDBKey k = {c.activity(), learnts[i]};
+            reduce_keys.push(k);
+        }
+    }
+
+    std::sort((ReduceDBKey *)reduce_keys, (ReduceDBKey *)reduce_keys + reduce_keys.size());
+
+    vec<Lit> kept;
+    for (int i = reduce_keys.size() - 1; i >= 0 && propagations < props_limit; i--)
+    {
+        CRef cr = reduce_keys[i].cref;
+        Clause &c = ca[cr];
+        if (satisfied(c))
+        {
+            removeClause(cr);
+            continue;
+        }
+
+        detachClause(cr, true);
+
+        kept.clear();
+        for (int k = 0; k < c.size(); k++)
+        {
+            Lit l = c[k];
+            if (value(l) == l_False)
+            {
+                continue;
+            }
+
+            kept.push(l);
+            if (value(l) == l_True)
+            {
+                break;
+            }
+
+            newDecisionLevel();
+            uncheckedEnqueue(~l);
+            if (propagate() != CRef_Undef)
+            {
+                break;
+            }
+        }
+
+        cancelUntil(0);
+
+        if (kept.size() == 0)
+        {
+            return false;
+        }
+
+        if (kept.size() == 1)
+        {
+            // The learnt clause is removed, the unit implies it:
+            c.mark(1);
+            ca.free(cr);
+            uncheckedEnqueue(kept[0]);
+            if (propagate() != CRef_Undef)
+            {
+                return false;
+            }
+
+            continue;
+        }
+
+        for (int k = 0; k < kept.size(); k++)
+        {
+            c[k] = kept[k];
+        }
+
+        c.shrink(c.size() - kept.size());
+        attachClause(cr);
+    }
+
+    // Drop the learnt clauses that were removed:
+    int i, j;
+    for (i = j = 0; i < learnts.size(); i++)
+    {
+        if (!isRemoved(learnts[i]))
+        {
+            learnts[j++] = learnts[i];
+        }
+    }
+
+    learnts.shrink(i - j);
+    return true;
+}
+
+static inline uint32_t abstractLits(const Clause &c)
+{
+    uint32_t abstraction = 0;
+    for (int i = 0; i < c.size(); i++)
+    {
+        abstraction |= 1 << (var(c[i]) & 31);
+    }
+
+    return abstraction;
+}
+
+void Solver::buildOccurrences(const vec<CRef> &cs, bool clear)
+{
+    if (clear)
+    {
+        occurs.clear();
+        occurs.growTo(nVars());
+    }
+
+    for (int i = 0; i < cs.size(); i++)
+    {
+        const Clause &c = ca[cs[i]];
+        if (c.mark() == 0)
+        {
+            Occurrence o = {cs[i], abstractLits(c)};
+            for (int j = 0; j < c.size(); j++)
+            {
+                occurs[var(c[j])].push(o);
+            }
+        }
+    }
+}
+
+bool Solver::subsumeLearnts(int64_t)
+{
+    // Subsumption is limited in steps and time rather than in propagations:
+    return subsume(threadCpuTime() + subsume_time, subsume_steps);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  subsume : (time_limit : double) (step_limit : int64_t)  ->  [bool]
+|
+|  Description:
+|    Checks the clauses of 'subsumption_queue' against all clauses, using occurrence lists of the
+|    variables and the clause abstractions to reject most pairs early. A learnt clause is first
+|    removed if another clause subsumes it. Then every clause 'c' removes the clauses it subsumes
+|    and strengthens the ones it resolves with into a subset (self-subsuming resolution).
+|    Strengthened clauses are queued again. A learnt 'c' only removes learnt clauses, but may
+|    strengthen all since it is implied by the original ones. Clauses that are reasons or
+|    satisfied at level 0 are left alone. A step is a visited occurrence, or a literal scanned in
+|    a pair that passes the abstraction test. Stops after 'step_limit' steps (unless 0), which keeps
+|    the pass deterministic, or at 'time_limit' (CPU seconds of the calling thread) on a slow
+|    machine, leaving the rest of the queue for the next pass. Returns FALSE if the clauses were
+|    found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::subsume(double time_limit, int64_t step_limit)
+{
+    assert(decisionLevel() == 0);
+
+    // The abstractions of the occurrences are those at the time of insertion, strengthening only
+    // clears bits so they stay over-approximations:
+    buildOccurrences(clauses);
+    buildOccurrences(learnts, false);
+
+    uint64_t clauses_checked = 0;
+    int64_t steps = 0;
+    int head;
+    for (head = 0; head < subsumption_queue.size(); head++)
+    {
+        CRef cr = subsumption_queue[head];
+        const Clause &c = ca[cr];
+        if (c.mark() != 0 || satisfied(c))
+        {
+            continue;
+        }
+
+        if ((step_limit > 0 && steps > step_limit) || ((++clauses_checked & 63) == 0 && threadCpuTime() > time_limit))
+        {
+            break;
+        }
+
+        uint32_t c_abs = abstractLits(c);
+
+        // Forward: is the learnt clause subsumed by another one?
+        bool subsumed = false;
+        for (int i = 0; c.learnt() && i < c.size() && !subsumed; i++)
+        {
+            const vec<Occurrence> &os = occurs[var(c[i])];
+            steps += os.size();
+            for (int k = 0; k < os.size(); k++)
+            {
+                const Clause &d = ca[os[k].cref];
+                if (d.size() <= c.size() && (os[k].abs & ~c_abs) == 0)
+                {
+                    steps += c.size();
+                }
+
+                if (os[k].cref != cr && d.mark() == 0 && d.subsumes(c, os[k].abs, c_abs) == lit_Undef)
+                {
+                    subsumed = true;
+                    break;
+                }
+            }
+        }
+
+        if (subsumed)
+        {
+            removeClause(cr);
+            subsumed_clauses++;
+            continue;
+        }
+
+        // Backward: remove or strengthen the clauses containing its least frequent variable:
+        Var best = var(c[0]);
+        for (int i = 1; i < c.size(); i++)
+        {
+            if (occurs[var(c[i])].size() < occurs[best].size())
+            {
+                best = var(c[i]);
+            }
+        }
+
+        vec<Occurrence> &os = occurs[best];
+        steps += os.size();
+        for (int k = 0; k < os.size(); k++)
+        {
+            CRef dr = os[k].cref;
+            Clause &d = ca[dr];
+            if (dr == cr || d.mark() != 0)
+            {
+                continue;
+            }
+
+            if (d.size() >= c.size() && (c_abs & ~os[k].abs) == 0)
+            {
+                steps += d.size();
+            }
+
+            Lit l = c.subsumes(d, c_abs, os[k].abs);
+            if (l == lit_Error || locked(d) || satisfied(d))
+            {
+                continue;
+            }
+
+            if (l == lit_Undef)
+            {
+                if (!c.learnt() || d.learnt())
+                {
+                    removeClause(dr);
+                    subsumed_clauses++;
+                }
+
+                continue;
+            }
+
+            // Strengthen 'd' by removing '~l', and the false literals that must not be watched:
+            strengthened_clauses++;
+            detachClause(dr, true);
+            remove(d, ~l);
+            int i, j;
+            for (i = j = 0; i < d.size(); i++)
+            {
+                if (value(d[i]) != l_False)
+                {
+                    d[j++] = d[i];
+                }
+            }
+
+            d.shrink(i - j);
+            if (d.size() <= 1)
+            {
+                bool empty = d.size() == 0;
+                Lit unit = empty ? lit_Undef : d[0];
+                d.mark(1);
+                ca.free(dr);
+                if (empty || (uncheckedEnqueue(unit), propagate() != CRef_Undef))
+                {
+                    return ok = false;
+                }
+            }
+            else
+            {
+                attachClause(dr);
+                subsumption_queue.push(dr);
+            }
+
+            if (c.mark() != 0)
+            {
+                break;
+            }
+        }
+    }
+
+    // Keep the unprocessed part of the queue, drop the removed clauses:
+    int i, j;
+    for (i = head, j = 0; i < subsumption_queue.size(); i++)
+    {
+        if (!isRemoved(subsumption_queue[i]))
+        {
+            subsumption_queue[j++] = subsumption_queue[i];
+        }
+    }
+
+    subsumption_queue.shrink(i - j);
+    occurs.clear(true);
+
+    for (int k = 0; k < 2; k++)
+    {
+        vec<CRef> &cs = k == 0 ? clauses : learnts;
+        for (i = j = 0; i < cs.size(); i++)
+        {
+            if (!isRemoved(cs[i]))
+            {
+                cs[j++] = cs[i];
+            }
+        }
+
+        cs.shrink(i - j);
+    }
+
+    checkGarbage();
+    return true;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  merge : (ps : const Clause&) (qs : const Clause&) (v : Var) (out_clause : vec<Lit>&)  ->  [bool]
+|
+|  Description:
+|    Resolves 'ps' and 'qs' on 'v' into 'out_clause'. Returns FALSE if the resolvent is a tautology.
+|________________________________________________________________________________________________@*/
+bool Solver::merge(const Clause &_ps, const Clause &_qs, Var v, vec<Lit> &out_clause)
+{
+    bool ps_smallest = _ps.size() < _qs.size();
+    const Clause &ps = ps_smallest ? _qs : _ps;
+    const Clause &qs = ps_smallest ? _ps : _qs;
+
+    out_clause.clear();
+    for (int i = 0; i < qs.size(); i++)
+    {
+        if (var(qs[i]) != v)
+        {
+            for (int j = 0; j < ps.size(); j++)
+            {
+                if (var(ps[j]) == var(qs[i]))
+                {
+                    if (ps[j] == ~qs[i])
+                    {
+                        return false;
+                    }
+
+                    goto next;
+                }
+            }
+
+            out_clause.push(qs[i]);
+        }
+    next:;
+    }
+
+    for (int i = 0; i < ps.size(); i++)
+    {
+        if (var(ps[i]) != v)
+        {
+            out_clause.push(ps[i]);
+        }
+    }
+
+    return true;
+}
+
+// Saves a clause of an eliminated variable 'v' (first) on the elimination stack, followed by its size:
+static void mkElimClause(vec<uint32_t> &elimclauses, Var v, const Clause &c)
+{
+    int first = elimclauses.size();
+    int v_pos = -1;
+    for (int i = 0; i < c.size(); i++)
+    {
+        elimclauses.push(toInt(c[i]));
+        if (var(c[i]) == v)
+        {
+            v_pos = i + first;
+        }
+    }
+
+    assert(v_pos != -1);
+    uint32_t tmp = elimclauses[v_pos];
+    elimclauses[v_pos] = elimclauses[first];
+    elimclauses[first] = tmp;
+    elimclauses.push(c.size());
+}
+
+static void mkElimClause(vec<uint32_t> &elimclauses, Lit x)
+{
+    elimclauses.push(toInt(x));
+    elimclauses.push(1);
+}
+
+/*_________________________________________________________________________________________________
+|
+|  eliminateVar : (v : Var)  ->  [bool]
+|
+|  Description:
+|    Replaces the clauses of 'v' by their non-tautological resolvents on 'v', unless there would be
+|    more than 'grow' additional clauses or a resolvent longer than 'clause_lim'. The clauses of the
+|    smaller side are saved on the elimination stack for 'extendModel()'. Returns FALSE if the
+|    clauses were found unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::eliminateVar(Var v)
+{
+    vec<CRef> pos, neg;
+    vec<Lit> resolvent;
+    const vec<Occurrence> &os = occurs[v];
+    for (int i = 0; i < os.size(); i++)
+    {
+        const Clause &c = ca[os[i].cref];
+        if (c.mark() != 0)
+        {
+            continue;
+        }
+
+        if (satisfied(c))
+        {
+            removeClause(os[i].cref);
+            continue;
+        }
+
+        (find(c, mkLit(v)) ? pos : neg).push(os[i].cref);
+    }
+
+    // Check whether the increase in number of clauses stays within the allowed ('grow'):
+    int cnt = 0;
+    for (int i = 0; i < pos.size(); i++)
+    {
+        for (int j = 0; j < neg.size(); j++)
+        {
+            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) &&
+                (++cnt > pos.size() + neg.size() + grow || (clause_lim != -1 && resolvent.size() > clause_lim)))
+            {
+                return true;
+            }
+        }
+    }
+
+    // Delete and store the old clauses:
+    eliminated[v] = true;
+    setDecisionVar(v, false);
+    eliminated_vars++;
+
+    if (pos.size() > neg.size())
+    {
+        for (int i = 0; i < neg.size(); i++)
+        {
+            mkElimClause(elimclauses, v, ca[neg[i]]);
+        }
+
+        mkElimClause(elimclauses, mkLit(v));
+    }
+    else
+    {
+        for (int i = 0; i < pos.size(); i++)
+        {
+            mkElimClause(elimclauses, v, ca[pos[i]]);
+        }
+
+        mkElimClause(elimclauses, ~mkLit(v));
+    }
+
+    // Produce the resolvents, then remove the clauses:
+    for (int i = 0; i < pos.size(); i++)
+    {
+        for (int j = 0; j < neg.size(); j++)
+        {
+            if (merge(ca[pos[i]], ca[neg[j]], v, resolvent) && !addResolvent(resolvent))
+            {
+                return false;
+            }
+        }
+    }
+
+    for (int i = 0; i < pos.size(); i++)
+    {
+        removeClause(pos[i]);
+    }
+
+    for (int i = 0; i < neg.size(); i++)
+    {
+        removeClause(neg[i]);
+    }
+
+    occurs[v].clear(true);
+    return true;
+}
+
+// Adds a resolvent as an original clause at level 0, without its false literals:
+bool Solver::addResolvent(vec<Lit> &ps)
+{
+    int i, j;
+    for (i = j = 0; i < ps.size(); i++)
+    {
+        if (value(ps[i]) == l_True)
+        {
+            return true;
+        }
+        else if (value(ps[i]) != l_False)
+        {
+            ps[j++] = ps[i];
+        }
+    }
+
+    ps.shrink(i - j);
+    if (ps.size() == 0)
+    {
+        return ok = false;
+    }
+    else if (ps.size() == 1)
+    {
+        uncheckedEnqueue(ps[0]);
+        return ok = (propagate() == CRef_Undef);
+    }
+
+    CRef cr = ca.alloc(ps, false);
+    clauses.push(cr);
+    attachClause(cr);
+
+    Occurrence o = {cr, abstractLits(ca[cr])};
+    for (int k = 0; k < ps.size(); k++)
+    {
+        occurs[var(ps[k])].push(o);
+    }
+
+    return true;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  eliminate : [void]  ->  [bool]
+|
+|  Description:
+|    Bounded variable elimination of the variables that are not frozen, in order of increasing
+|    number of occurrences. Circuit inputs and outputs are kept, and so are all gate operands if
+|    the branching heuristic walks the J-frontiers (it only decides on operands and needs them to
+|    keep their clauses). Learnt clauses on eliminated variables are removed.
+|________________________________________________________________________________________________@*/
+bool Solver::eliminate()
+{
+    assert(decisionLevel() == 0);
+    if (!ok)
+    {
+        return false;
+    }
+
+    vec<char> keep(nVars(), 0);
+    for (Var v = 0; v < nVars(); v++)
+    {
+        keep[v] = frozen[v];
+    }
+
+    if (csat_instance)
+    {
+        for (size_t input : csat_instance.get()->getInputGates())
+        {
+            keep[input] = true;
+        }
+
+        for (size_t output : csat_instance.get()->getOutputGates())
+        {
+            keep[output] = true;
+        }
+
+        for (size_t gate = 0; gate < csat_instance.get()->getNumberOfGates() && branching != branch_order; gate++)
+        {
+            for (size_t operand : csat_instance.get()->getGateOperands(gate))
+            {
+                keep[operand] = true;
+            }
+        }
+    }
+
+    buildOccurrences(clauses);
+
+    vec<Var> elim_order;
+    for (Var v = 0; v < nVars(); v++)
+    {
+        if (!keep[v] && !eliminated[v] && decision[v] && value(v) == l_Undef)
+        {
+            elim_order.push(v);
+        }
+    }
+
+    sort(elim_order, ElimLt(occurs));
+
+    double start_time = cpuTime();
+    uint64_t eliminated_before = eliminated_vars;
+    for (int i = 0; i < elim_order.size() && ok; i++)
+    {
+        if (value(elim_order[i]) == l_Undef && !eliminateVar(elim_order[i]))
+        {
+            ok = false;
+        }
+    }
+
+    occurs.clear(true);
+
+    // Remove the learnt clauses of eliminated variables (only possible in later calls to 'solve()'):
+    for (int i = 0; i < learnts.size(); i++)
+    {
+        const Clause &c = ca[learnts[i]];
+        for (int k = 0; k < c.size(); k++)
+        {
+            if (eliminated[var(c[k])])
+            {
+                removeClause(learnts[i]);
+                break;
+            }
+        }
+    }
+
+    for (int k = 0; k < 2; k++)
+    {
+        vec<CRef> &cs = k == 0 ? clauses : learnts;
+        int i, j;
+        for (i = j = 0; i < cs.size(); i++)
+        {
+            if (!isRemoved(cs[i]))
+            {
+                cs[j++] = cs[i];
+            }
+        }
+
+        cs.shrink(i - j);
+    }
+
+    if (verbosity >= 1 && ok)
+    {
+        printf("|  Eliminated vars:      %12" PRIu64 " (%5.2f s)                               |\n", eliminated_vars - eliminated_before, cpuTime() - start_time);
+    }
+
+    checkGarbage();
+    return ok;
+}
+
+// Assigns the eliminated variables in 'model' (in reverse order of elimination), such that the
+// clauses saved on the elimination stack are satisfied:
+void Solver::extendModel()
+{
+    // Substituted variables first, the clauses of eliminated variables may contain them:
+    for (Var v = 0; v < nVars(); v++)
+    {
+        if (representative[v] != mkLit(v))
+        {
+            model[v] = model[var(representative[v])] ^ sign(representative[v]);
+        }
+    }
+
+    int i, j;
+    Lit x;
+
+    for (i = elimclauses.size() - 1; i > 0; i -= j)
+    {
+        for (j = elimclauses[i--]; j > 1; j--, i--)
+        {
+            if (modelValue(toLit(elimclauses[i])) != l_False)
+            {
+                goto next;
+            }
+        }
+
+        x = toLit(elimclauses[i]);
+        model[var(x)] = lbool(!sign(x));
+    next:;
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  search : (nof_conflicts : int) (params : const SearchParams&)  ->  [lbool]
+|
+|  Description:
+|    Search for a model the specified number of conflicts.
+|    NOTE! Use negative value for 'nof_conflicts' indicate infinity.
+|
+|  Output:
+|    'l_True' if a partial assigment that is consistent with respect to the clauseset is found. If
+|    all variables are decision variables, this means that the clause set is satisfiable. 'l_False'
+|    if the clause set is unsatisfiable. 'l_Undef' if the bound on number of conflicts is reached.
+|
+|    Runs the instance of 'searchWith()' for the branching policy chosen by 'branching',
+|    'bp_activity' and 'bp_xor', or for the decision order once 'csat_start' restarts are over.
+|________________________________________________________________________________________________@*/
+lbool Solver::search(int nof_conflicts)
+{
+    if (branching == branch_order || (csat_start > 0 && starts >= (uint64_t)csat_start))
+    {
+        if (branching != branch_order && starts == (uint64_t)csat_start)
+        {
+            endCircuitStart();
+        }
+
+        return searchWith<OrderBranching>(nof_conflicts);
+    }
+    else if (branching == branch_jfrontier_activity)
+    {
+        return searchWith<JFrontierActivityBranching>(nof_conflicts);
+    }
+
+    switch (bp_xor)
+    {
+    case xor_prefer:
+        return bp_activity ? searchWith<BackpropBranching<true, xor_prefer> >(nof_conflicts)
+                           : searchWith<BackpropBranching<false, xor_prefer> >(nof_conflicts);
+    case xor_avoid:
+        return bp_activity ? searchWith<BackpropBranching<true, xor_avoid> >(nof_conflicts)
+                           : searchWith<BackpropBranching<false, xor_avoid> >(nof_conflicts);
+    default:
+        return bp_activity ? searchWith<BackpropBranching<true, xor_indifferent> >(nof_conflicts)
+                           : searchWith<BackpropBranching<false, xor_indifferent> >(nof_conflicts);
+    }
+}
+
+template <class B>
+lbool Solver::searchWith(int nof_conflicts)
+{
+    assert(ok);
+    int backtrack_level;
+    int conflictC = 0;
+    vec<Lit> learnt_clause;
+    starts++;
+
+    for (;;)
+    {
+        CRef confl = propagate();
+        if (confl != CRef_Undef)
+        {
+            // CONFLICT
+            conflicts++;
+            conflictC++;
+            int conflict_level = decisionLevel();
+            if (chrono >= 0 && conflict_level > 0)
+            {
+                bool single;
+                conflict_level = findConflictLevel(confl, single);
+                if (conflict_level > 0 && single)
+                {
+                    // The conflicting clause is unit one level below, no need to learn anything:
+                    Clause &c = ca[confl];
+                    cancelUntil(conflict_level - 1);
+                    uncheckedEnqueue(c[0], level(var(c[1])), confl);
+                    continue;
+                }
+            }
+
+            if (conflict_level == 0)
+            {
+                return l_False;
+            }
+
+            if (rephase_int > 0 || target_phase)
+            {
+                // Everything assigned before the conflicting level was propagated without conflict:
+                updatePhases(trail_lim[conflict_level - 1]);
+            }
+
+            learnt_clause.clear();
+            analyze(confl, learnt_clause, backtrack_level);
+            if (exchange != NULL && share_glue > 0)
+            {
+                shareLearnt(learnt_clause);
+            }
+
+            if (learnt_clause.size() == 1)
+            {
+                cancelUntil(0);
+                uncheckedEnqueue(learnt_clause[0]);
+            }
+            else
+            {
+                if (chrono >= 0 && decisionLevel() - backtrack_level > chrono)
+                {
+                    // Backtrack chronologically, the asserting literal is enqueued out of order:
+                    chrono_backtracks++;
+                    cancelUntil(conflict_level - 1);
+                }
+                else
+                {
+                    cancelUntil(backtrack_level);
+                }
+
+                CRef cr = ca.alloc(learnt_clause, true);
+                learnts.push(cr);
+                attachClause(cr);
+                if (subsume_time > 0 && inprocess_int > 0)
+                {
+                    subsumption_queue.push(cr);
+                }
+                claBumpActivity(ca[cr]);
+                uncheckedEnqueue(learnt_clause[0], backtrack_level, cr);
             }
 
             varDecayActivity();
@@ -1265,64 +3150,456 @@ lbool Solver::search(int nof_conflicts)
             // NO CONFLICT
             if ((nof_conflicts >= 0 && conflictC >= nof_conflicts) || !withinBudget())
             {
-                // Reached bound on number of conflicts:
-                progress_estimate = progressEstimate();
-                cancelUntil(0);
-                return l_Undef;
+                // Reached bound on number of conflicts:
+                progress_estimate = progressEstimate();
+                if (reuse_trail && withinBudget())
+                {
+                    int level = reusableTrailLevel<B>();
+                    reused_levels += level;
+                    cancelUntil(level);
+                }
+                else
+                {
+                    cancelUntil(0);
+                }
+
+                return l_Undef;
+            }
+
+            // Simplify the set of problem clauses:
+            if (decisionLevel() == 0 && !simplify())
+            {
+                return l_False;
+            }
+
+            if (learnts.size() - nAssigns() >= max_learnts)
+            {
+                // Reduce the set of learnt clauses:
+                reduceDB();
+            }
+
+            if (rephase_int > 0 && conflicts >= next_rephase)
+            {
+                rephase();
+            }
+
+            Lit next = lit_Undef;
+            while (decisionLevel() < assumptions.size())
+            {
+                // Perform user provided assumption:
+                Lit p = assumptions[decisionLevel()];
+                if (value(p) == l_True)
+                {
+                    // Dummy decision level:
+                    newDecisionLevel();
+                }
+                else if (value(p) == l_False)
+                {
+                    analyzeFinal(~p, conflict);
+                    return l_False;
+                }
+                else
+                {
+                    next = p;
+                    break;
+                }
+            }
+
+            if (next == lit_Undef)
+            {
+                // New variable decision:
+                decisions++;
+                next = pickBranchLit<B>();
+
+                if (next == lit_Undef)
+                {
+                    // Model found:
+                    return l_True;
+                }
+            }
+
+            // Increase decision level and enqueue 'next'
+            newDecisionLevel();
+            uncheckedEnqueue(next);
+        }
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  reusableTrailLevel : [void]  ->  [int]
+|
+|  Description:
+|    Trail reuse for restarts. The decisions of the lowest levels would be made again in the same
+|    order after a restart as long as the branching heuristic prefers them to the variable it would
+|    pick next now. Returns the highest such level, so that the restart can keep the trail up to it.
+|________________________________________________________________________________________________@*/
+template <class B>
+int Solver::reusableTrailLevel()
+{
+    Var next;
+    if constexpr (B::circuit)
+    {
+        next = pickBranchjFParent<B>();
+    }
+    else
+    {
+        next = pickOrderVar();
+    }
+
+    // 'pickOrderVar()' removed 'next' from the heap, it must stay a candidate:
+    if (next != var_Undef)
+    {
+        insertVarOrder(next);
+    }
+    else
+    {
+        return decisionLevel();
+    }
+
+    // Assumptions are always decided first and in the same order:
+    int level = assumptions.size() < decisionLevel() ? assumptions.size() : decisionLevel();
+    while (level < decisionLevel() && decidedBefore<B>(var(trail[trail_lim[level]]), next))
+    {
+        level++;
+    }
+
+    return level;
+}
+
+template <class B>
+bool Solver::decidedBefore(Var x, Var next) const
+{
+    if (B::kind == branch_backprop)
+    {
+        return distance_to_output[x] < distance_to_output[next];
+    }
+    else if (decision_order == 1 && B::kind == branch_order)
+    {
+        return vmtf_queue.stamp(x) > vmtf_queue.stamp(next);
+    }
+
+    return activity[x] > activity[next];
+}
+
+void Solver::updatePhases(int consistent)
+{
+    if (consistent > target_assigned)
+    {
+        for (int i = 0; i < consistent; i++)
+        {
+            target_polarity[var(trail[i])] = lbool(sign(trail[i]));
+        }
+
+        target_assigned = consistent;
+    }
+
+    if (consistent > best_assigned)
+    {
+        for (int i = 0; i < consistent; i++)
+        {
+            best_polarity[var(trail[i])] = lbool(sign(trail[i]));
+        }
+
+        best_assigned = consistent;
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  rephase : [void]  ->  [void]
+|
+|  Description:
+|    Overwrites the saved phases with the next entry of the schedule: (O)riginal, (I)nverted
+|    original, (B)est, (R)andom and the circuit-derived max-(P)robability and max-backpropagation
+|    (M) phases. Every other entry, starting with the first, is the best phase. The target phase
+|    starts over from the new phases. The interval to the next rephase grows by 'rephase_int'
+|    conflicts each time.
+|________________________________________________________________________________________________@*/
+static const char rephase_schedule[] = "BOBIBPBRBM";
+
+void Solver::rephase()
+{
+    const int schedule_size = sizeof(rephase_schedule) - 1;
+    char kind = rephase_schedule[rephases % schedule_size];
+    if ((kind == 'P' || kind == 'M') && !csat_instance)
+    {
+        kind = 'B';
+    }
+
+    rephases++;
+    next_rephase = conflicts + rephase_int * (rephases + 1);
+
+    int n_vars = nVars();
+    switch (kind)
+    {
+    case 'O':
+    case 'I':
+        if (polarity_init != polarity_default)
+        {
+            circuitPolarities(polarity_init == polarity_max_prob);
+        }
+        else
+        {
+            for (int var = 0; var < n_vars; ++var)
+            {
+                polarity[var] = DEFAULT_POLARITY_VALUE;
+            }
+        }
+
+        if (kind == 'I')
+        {
+            for (int var = 0; var < n_vars; ++var)
+            {
+                polarity[var] = !polarity[var];
+            }
+        }
+        break;
+    case 'B':
+        for (int var = 0; var < n_vars; ++var)
+        {
+            if (best_polarity[var] != l_Undef)
+            {
+                polarity[var] = best_polarity[var] == l_True;
+            }
+        }
+
+        best_assigned = 0;
+        break;
+    case 'R':
+        for (int var = 0; var < n_vars; ++var)
+        {
+            polarity[var] = drand(random_seed) < 0.5;
+        }
+        break;
+    case 'P':
+    case 'M':
+        circuitPolarities(kind == 'P');
+        break;
+    }
+
+    for (int var = 0; var < n_vars; ++var)
+    {
+        target_polarity[var] = l_Undef;
+    }
+
+    target_assigned = 0;
+
+    if (verbosity >= 2)
+    {
+        printf("| Rephase %-4c at %-12" PRIu64 "                                                |\n", kind, conflicts);
+    }
+}
+
+/*_________________________________________________________________________________________________
+|
+|  localSearch : [void]  ->  [void]
+|
+|  Description:
+|    Runs a round of local search over the circuit inputs, starting from the saved phases (and the
+|    values fixed at level 0), and overwrites the saved phases of all gates with the simulated
+|    values of the best assignment found. The target phase starts over from the new phases. The
+|    interval to the next round grows by 'ls_int' conflicts each time.
+|________________________________________________________________________________________________@*/
+void Solver::localSearch()
+{
+    ls_calls++;
+    next_local_search = conflicts + ls_int * (ls_calls + 1);
+
+    if (!local_search)
+    {
+        local_search.reset(new LocalSearch(*csat_instance));
+    }
+
+    int n_gates = (int)csat_instance->getNumberOfGates();
+    vec<char> init(n_gates, 0), fixed(n_gates, 0);
+    for (Var v = 0; v < n_gates && v < nVars(); v++)
+    {
+        if (value(v) != l_Undef && level(v) == 0)
+        {
+            init[v] = value(v) == l_True;
+            fixed[v] = 1;
+        }
+        else
+        {
+            init[v] = !polarity[v];
+        }
+    }
+
+    uint64_t start_flips = local_search->flips;
+    bool sat = local_search->search(init, fixed, ls_flips, random_seed);
+    ls_flips_total += local_search->flips - start_flips;
+
+    const vec<char> &best = local_search->bestValues();
+    for (Var v = 0; v < n_gates && v < nVars(); v++)
+    {
+        polarity[v] = !best[v];
+        target_polarity[v] = l_Undef;
+    }
+
+    target_assigned = 0;
+
+    if (verbosity >= 2)
+    {
+        printf("| Local search %-3s at %-12" PRIu64 " score %9d / %-9d                |\n",
+               sat ? "SAT" : "", conflicts, local_search->bestScore(), local_search->maxScore());
+    }
+}
+
+// Order independent, so a clause hashes the same however its literals are arranged:
+static uint64_t clauseHash(const vec<Lit> &lits)
+{
+    uint64_t h = 0;
+    for (int i = 0; i < lits.size(); i++)
+    {
+        uint64_t x = (uint64_t)toInt(lits[i]) * 0x9E3779B97F4A7C15ULL;
+        h += x ^ (x >> 29);
+    }
+
+    return h;
+}
+
+// The hashes are kept in a direct-mapped table, so its memory is bounded and a clause shared long
+// ago may pass again (it is then just a duplicate learnt clause):
+bool Solver::sharedBefore(const vec<Lit> &lits)
+{
+    if (shared_hashes.size() == 0)
+    {
+        shared_hashes.growTo(1 << share_filter_bits, 0);
+    }
+
+    uint64_t h = clauseHash(lits) | 1;
+    uint64_t &slot = shared_hashes[h & ((1 << share_filter_bits) - 1)];
+    if (slot == h)
+    {
+        return true;
+    }
+
+    slot = h;
+    return false;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  shareLearnt : (lits : const vec<Lit>&)  ->  [void]
+|
+|  Description:
+|    Exports a learnt clause to the other solvers if it has at most 'share_size' literals and a
+|    glue within the current limit (units always qualify). Every 'share_period' conflicts the limit
+|    is moved by one towards 'share_target' exports per period, between 1 and 'share_size'.
+|________________________________________________________________________________________________@*/
+void Solver::shareLearnt(const vec<Lit> &lits)
+{
+    if (conflicts >= next_share_adjust)
+    {
+        if (export_window < share_target / 2 && export_glue < share_size)
+        {
+            export_glue++;
+        }
+        else if (export_window > share_target * 2 && export_glue > 1)
+        {
+            export_glue--;
+        }
+
+        export_window = 0;
+        next_share_adjust = conflicts + share_period;
+    }
+
+    if (lits.size() > share_size || (lits.size() > 1 && computeLBD(lits) > export_glue))
+    {
+        return;
+    }
+
+    exchange->push(exchange_id, lits);
+    sharedBefore(lits);
+    shared_exported++;
+    export_window++;
+}
+
+/*_________________________________________________________________________________________________
+|
+|  importClauses : [void]  ->  [bool]
+|
+|  Description:
+|    Adds the clauses exported by the other solvers since the last call as learnt clauses (at
+|    level 0). They are implied by the original problem, so only variables this solver eliminated
+|    are a concern: such clauses are dropped, and substituted variables are replaced by their
+|    representatives. Clauses seen recently (by hash) are skipped. Returns FALSE if the problem
+|    became unsatisfiable.
+|________________________________________________________________________________________________@*/
+bool Solver::importClauses()
+{
+    assert(decisionLevel() == 0);
+
+    vec<Lit> lits;
+    while (ok && exchange->pull(exchange_id, exchange_cursor, lits))
+    {
+        bool skip = false;
+        for (int i = 0; i < lits.size() && !skip; i++)
+        {
+            if (var(lits[i]) >= nVars())
+            {
+                skip = true;
             }
-
-            // Simplify the set of problem clauses:
-            if (decisionLevel() == 0 && !simplify())
+            else
             {
-                return l_False;
+                lits[i] = representative[var(lits[i])] ^ sign(lits[i]);
+                skip = eliminated[var(lits[i])];
             }
+        }
 
-            if (learnts.size() - nAssigns() >= max_learnts)
+        if (skip || sharedBefore(lits))
+        {
+            continue;
+        }
+
+        // Remove duplicates and false literals, skip tautologies and satisfied clauses:
+        sort(lits);
+        Lit prev = lit_Undef;
+        int i, j;
+        for (i = j = 0; i < lits.size(); i++)
+        {
+            if (value(lits[i]) == l_True || lits[i] == ~prev)
             {
-                // Reduce the set of learnt clauses:
-                reduceDB();
+                break;
             }
-
-            Lit next = lit_Undef;
-            while (decisionLevel() < assumptions.size())
+            else if (value(lits[i]) == l_Undef && lits[i] != prev)
             {
-                // Perform user provided assumption:
-                Lit p = assumptions[decisionLevel()];
-                if (value(p) == l_True)
-                {
-                    // Dummy decision level:
-                    newDecisionLevel();
-                }
-                else if (value(p) == l_False)
-                {
-                    analyzeFinal(~p, conflict);
-                    return l_False;
-                }
-                else
-                {
-                    next = p;
-                    break;
-                }
+                lits[j++] = prev = lits[i];
             }
+        }
 
-            if (next == lit_Undef)
-            {
-                // New variable decision:
-                decisions++;
-                next = pickBranchLit();
+        if (i < lits.size())
+        {
+            continue;
+        }
 
-                if (next == lit_Undef)
-                {
-                    // Model found:
-                    return l_True;
-                }
-            }
+        lits.shrink(i - j);
+        shared_imported++;
 
-            // Increase decision level and enqueue 'next'
-            newDecisionLevel();
-            uncheckedEnqueue(next);
+        if (lits.size() == 0)
+        {
+            ok = false;
+        }
+        else if (lits.size() == 1)
+        {
+            uncheckedEnqueue(lits[0]);
+        }
+        else
+        {
+            CRef cr = ca.alloc(lits, true);
+            ca[cr].imported(true);
+            learnts.push(cr);
+            attachClause(cr);
+            if (subsume_time > 0 && inprocess_int > 0)
+            {
+                subsumption_queue.push(cr);
+            }
+            claBumpActivity(ca[cr]);
         }
     }
+
+    return ok = ok && propagate() == CRef_Undef;
 }
 
 double Solver::progressEstimate() const
@@ -1373,13 +3650,20 @@ static double luby(double y, int x)
 // NOTE: assumptions passed in member-variable 'assumptions'.
 lbool Solver::solve_()
 {
-#ifdef BACKPROP
-    countDistances();
-#endif
+    if (branching == branch_backprop)
+    {
+        countDistances();
+        if (podem)
+        {
+            computeControllability();
+        }
+    }
+
+    if (polarity_init != polarity_default)
+    {
+        setDefaultPolarities();
+    }
 
-#if defined POLARITY_INIT_MAXPROB || defined POLARITY_INIT_MAXBACKPROP
-    setDefaultPolarities();
-#endif
     model.clear();
     conflict.clear();
     if (!ok)
@@ -1389,6 +3673,34 @@ lbool Solver::solve_()
 
     solves++;
 
+    if (!preprocessed)
+    {
+        // The schedules start from the parameters in effect at the first solve:
+        preprocessed = true;
+        next_rephase = rephase_int;
+        next_inprocess = inprocess_int;
+        next_local_search = ls_int;
+        if (subsume_time > 0)
+        {
+            // One pass over the original clauses, the learnt clauses are handled as they are learnt:
+            for (int i = 0; i < clauses.size(); i++)
+            {
+                subsumption_queue.push(clauses[i]);
+            }
+
+            if (!subsume(threadCpuTime() + subsume_time, subsume_steps))
+            {
+                return l_False;
+            }
+        }
+
+        // The circuit branchings keep every gate operand, so there is little to eliminate for them:
+        if ((use_elim == 1 || (use_elim == 2 && branching == branch_order)) && !eliminate())
+        {
+            return l_False;
+        }
+    }
+
     max_learnts = nClauses() * learntsize_factor;
     if (max_learnts < min_learnts_lim)
     {
@@ -1399,6 +3711,15 @@ lbool Solver::solve_()
     learntsize_adjust_cnt = (int)learntsize_adjust_confl;
     lbool status = l_Undef;
 
+    if (verbosity >= 1 && cache_miss_counter < 0)
+    {
+        cache_miss_counter = openCacheMissCounter();
+    }
+
+    uint64_t start_misses = readCacheMissCounter(cache_miss_counter);
+    gc_misses = start_misses;
+    gc_propagations = propagations;
+
     if (verbosity >= 1)
     {
         printf("============================[ Search Statistics ]==============================\n");
@@ -1409,28 +3730,46 @@ lbool Solver::solve_()
 
     // Search:
     int curr_restarts = 0;
-#ifdef CSAT_HEURISTIC_START
-    int default_restart_first = restart_first;
-    restart_first = RFIRST_CSAT;
-#endif
+    bool circuit_start = csat_start > 0 && branching != branch_order && starts < (uint64_t)csat_start;
+    int first = circuit_start ? RFIRST_CSAT : restart_first;
     while (status == l_Undef)
     {
         double rest_base = luby_restart ? luby(restart_inc, curr_restarts) : pow(restart_inc, curr_restarts);
-        status = search(rest_base * restart_first);
+        status = search(rest_base * first);
         if (!withinBudget())
         {
             break;
         }
 
+        if (status == l_Undef && ls_int > 0 && csat_instance && conflicts >= next_local_search)
+        {
+            localSearch();
+        }
+
+        if (status == l_Undef && inprocess_int > 0 && conflicts >= next_inprocess)
+        {
+            cancelUntil(0);
+            if (!inprocess())
+            {
+                status = l_False;
+            }
+        }
+
+        if (status == l_Undef && exchange != NULL && exchange->pending(exchange_cursor))
+        {
+            cancelUntil(0);
+            if (!importClauses())
+            {
+                status = l_False;
+            }
+        }
+
         curr_restarts++;
-#if defined CSAT_HEURISTIC_START && RESET_RESTARTS
-        if (starts == DEFAULT_HEURISTIC_AFTER_N_RESTARTS)
+        first = restart_first;
+        if (circuit_start && RESET_RESTARTS && starts == (uint64_t)csat_start)
         {
             curr_restarts = 0;
         }
-
-        restart_first = default_restart_first;
-#endif
     }
 
     if (verbosity >= 1)
@@ -1446,12 +3785,15 @@ lbool Solver::solve_()
         {
             model[i] = value(i);
         }
+
+        extendModel();
     }
     else if (status == l_False && conflict.size() == 0)
     {
         ok = false;
     }
 
+    cache_misses += readCacheMissCounter(cache_miss_counter) - start_misses;
     cancelUntil(0);
     return status;
 }
@@ -1493,6 +3835,131 @@ bool Solver::implies(const vec<Lit> &assumps, vec<Lit> &out)
     return ret;
 }
 
+/*_________________________________________________________________________________________________
+|
+|  lookaheadCubes : (max_cubes : int) (cubes : vec<vec<Lit> >&)  ->  [bool]
+|
+|  Description:
+|    Splits the problem into at most 'max_cubes' cubes (conjunctions of literals that cover all
+|    solutions), breadth first. Each cube is split on the variable whose two phases propagate the
+|    most (the product of the two propagation counts) among the first 'lookahead_candidates'
+|    unassigned variables in order of preference: circuit inputs first, then the gates closest to
+|    the outputs. Cubes refuted by propagation are dropped. Returns FALSE if the problem is
+|    unsatisfiable (all cubes were refuted).
+|________________________________________________________________________________________________@*/
+bool Solver::lookaheadCubes(int max_cubes, vec<vec<Lit> > &cubes)
+{
+    cubes.clear();
+    if (!simplify())
+    {
+        return false;
+    }
+
+    // Order of preference of the splitting variables:
+    vec<Var> candidates;
+    vec<int> key(nVars(), 0);
+    if (csat_instance)
+    {
+        countDistances();
+        for (Var v = 0; v < nVars() && v < (int)distance_to_output.size(); v++)
+        {
+            key[v] = csat_instance->getGateType(v) == csat::GateType::INPUT ? 0 : 1 + distance_to_output[v];
+        }
+    }
+
+    for (Var v = 0; v < nVars(); v++)
+    {
+        if (decision[v] && !eliminated[v])
+        {
+            candidates.push(v);
+        }
+    }
+
+    std::stable_sort((Var *)candidates, (Var *)candidates + candidates.size(), [&](Var x, Var y) { return key[x] < key[y]; });
+
+    vec<vec<Lit> > open;
+    open.push();
+    vec<Lit> cube;
+    int head = 0;
+    for (; head < open.size() && cubes.size() + open.size() - head < max_cubes; head++)
+    {
+        open[head].copyTo(cube);
+        open[head].clear(true);
+
+        bool refuted = false;
+        for (int i = 0; i < cube.size() && !refuted; i++)
+        {
+            if (value(cube[i]) == l_False)
+            {
+                refuted = true;
+            }
+            else if (value(cube[i]) == l_Undef)
+            {
+                newDecisionLevel();
+                uncheckedEnqueue(cube[i]);
+                refuted = propagate() != CRef_Undef;
+            }
+        }
+
+        // Lookahead on both phases of the candidates:
+        Var best = var_Undef;
+        double best_score = -1;
+        for (int i = 0, tried = 0; i < candidates.size() && tried < lookahead_candidates && !refuted; i++)
+        {
+            Var x = candidates[i];
+            if (value(x) != l_Undef)
+            {
+                continue;
+            }
+
+            tried++;
+            int trail_before = trail.size();
+            double score = 1;
+            for (int phase = 0; phase < 2; phase++)
+            {
+                newDecisionLevel();
+                uncheckedEnqueue(mkLit(x, phase));
+                bool failed = propagate() != CRef_Undef;
+                score *= failed ? 1e9 : trail.size() - trail_before;
+                cancelUntil(decisionLevel() - 1);
+            }
+
+            if (score > best_score)
+            {
+                best = x;
+                best_score = score;
+            }
+        }
+
+        cancelUntil(0);
+        if (refuted)
+        {
+            continue;
+        }
+        else if (best == var_Undef)
+        {
+            cubes.push();
+            cube.copyTo(cubes.last());
+            continue;
+        }
+
+        for (int phase = 0; phase < 2; phase++)
+        {
+            open.push();
+            cube.copyTo(open.last());
+            open.last().push(mkLit(best, phase));
+        }
+    }
+
+    for (; head < open.size(); head++)
+    {
+        cubes.push();
+        open[head].copyTo(cubes.last());
+    }
+
+    return cubes.size() > 0;
+}
+
 //=================================================================================================
 // Writing CNF to DIMACS:
 //
@@ -1607,7 +4074,75 @@ void Solver::printStats() const
     printf("conflicts             : %-12" PRIu64 "   (%.0f /sec)\n", conflicts, conflicts / cpu_time);
     printf("decisions             : %-12" PRIu64 "   (%4.2f %% random) (%.0f /sec)\n", decisions, (float)rnd_decisions * 100 / (float)decisions, decisions / cpu_time);
     printf("propagations          : %-12" PRIu64 "   (%.0f /sec)\n", propagations, propagations / cpu_time);
-    printf("conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted)\n", tot_literals, (max_literals - tot_literals) * 100 / (double)max_literals);
+    if (cache_miss_counter >= 0)
+    {
+        printf("cache misses          : %-12" PRIu64 "   (%.2f /propagation)\n", cache_misses, cache_misses / (double)propagations);
+    }
+
+    printf("conflict literals     : %-12" PRIu64 "   (%4.2f %% deleted, %" PRIu64 " by binary clauses)\n", tot_literals, (max_literals - tot_literals) * 100 / (double)max_literals, bin_min_literals);
+    if (reuse_trail)
+    {
+        printf("reused levels         : %-12" PRIu64 "   (%.2f /restart)\n", reused_levels, reused_levels / (double)starts);
+    }
+
+    if (inprocess_int > 0 && probe_units + probe_hbrs > 0)
+    {
+        printf("probing units         : %-12" PRIu64 "   (%" PRIu64 " hyper-binary resolvents)\n", probe_units, probe_hbrs);
+    }
+
+    if (substituted_vars > 0)
+    {
+        printf("substituted vars      : %-12" PRIu64 "\n", substituted_vars);
+    }
+
+    if (eliminated_vars > 0)
+    {
+        printf("eliminated vars       : %-12" PRIu64 "\n", eliminated_vars);
+    }
+
+    if (subsume_time > 0)
+    {
+        printf("subsumed clauses      : %-12" PRIu64 "   (%" PRIu64 " strengthened)\n", subsumed_clauses, strengthened_clauses);
+    }
+
+    if (inprocess_int > 0)
+    {
+        printf("inprocessings         : %-12" PRIu64 "\n", inprocessings);
+        for (int i = 0; i < techniques.size(); i++)
+        {
+            const Technique &t = techniques[i];
+            if (t.calls > 0)
+            {
+                printf("  %-20s: %-12" PRIu64 "   (%.2f s, %" PRId64 " clauses, %" PRId64 " literals removed)\n",
+                       t.name, t.calls, t.time, t.clauses_removed, t.literals_removed);
+            }
+        }
+    }
+
+    if (rephase_int > 0)
+    {
+        printf("rephases              : %-12" PRIu64 "\n", rephases);
+    }
+
+    if (podem_decisions > 0)
+    {
+        printf("podem decisions       : %-12" PRIu64 "   (%4.2f %% of decisions)\n", podem_decisions, podem_decisions * 100 / (double)decisions);
+    }
+
+    if (ls_calls > 0)
+    {
+        printf("local search rounds   : %-12" PRIu64 "   (%" PRIu64 " flips)\n", ls_calls, ls_flips_total);
+    }
+    if (exchange != NULL)
+    {
+        printf("shared clauses        : %-12" PRIu64 "   (%" PRIu64 " imported, %" PRIu64 " useful)\n", shared_exported, shared_imported, shared_useful);
+    }
+
+    if (chrono >= 0)
+    {
+        printf("chrono backtracks     : %-12" PRIu64 "   (%4.2f %% of conflicts)\n", chrono_backtracks, chrono_backtracks * 100 / (double)conflicts);
+    }
+
     if (mem_used != 0)
     {
         printf("Memory used           : %.2f MB\n", mem_used);
@@ -1721,9 +4256,72 @@ bool Solver::verifySolution()
 
 void Solver::relocAll(ClauseAllocator &to)
 {
+    watches.cleanAll();
+    if (gc_locality)
+    {
+        // Relocate in the order 'propagate()' visits the watches: those of the trail, then of the
+        // unassigned variables in decision order (decided polarity first), then of the false literals.
+        // All original clauses go first so that deleting learnts never fragments them:
+        vec<Lit> order;
+        vec<Var> vs;
+        if (decision_order == 1)
+        {
+            for (Var v = vmtf_queue.last(); v != var_Undef; v = vmtf_queue.prev(v))
+            {
+                if (value(v) == l_Undef)
+                {
+                    vs.push(v);
+                }
+            }
+        }
+        else
+        {
+            for (Var v = 0; v < nVars(); v++)
+            {
+                if (value(v) == l_Undef)
+                {
+                    vs.push(v);
+                }
+            }
+
+            sort(vs, VarOrderLt(activity));
+        }
+
+        for (int i = 0; i < trail.size(); i++)
+        {
+            order.push(trail[i]);
+        }
+
+        for (int i = 0; i < vs.size(); i++)
+        {
+            order.push(mkLit(vs[i], polarity[vs[i]]));
+            order.push(mkLit(vs[i], !polarity[vs[i]]));
+        }
+
+        for (int i = 0; i < trail.size(); i++)
+        {
+            order.push(~trail[i]);
+        }
+
+        for (int learnt = 0; learnt < 2; learnt++)
+        {
+            for (int i = 0; i < order.size(); i++)
+            {
+                vec<Watcher> &ws = watches[order[i]];
+                for (int j = 0; j < ws.size(); j++)
+                {
+                    CRef cr = ws[j].cref;
+                    if (ca[cr].learnt() == (learnt == 1))
+                    {
+                        ca.reloc(cr, to);
+                    }
+                }
+            }
+        }
+    }
+
     // All watchers:
     //
-    watches.cleanAll();
     for (int v = 0; v < nVars(); v++)
     {
         for (int s = 0; s < 2; s++)
@@ -1732,7 +4330,10 @@ void Solver::relocAll(ClauseAllocator &to)
             vec<Watcher> &ws = watches[p];
             for (int j = 0; j < ws.size(); j++)
             {
-                ca.reloc(ws[j].cref, to);
+                // (copied since a packed watcher's field cannot be bound to a reference)
+                CRef cr = ws[j].cref;
+                ca.reloc(cr, to);
+                ws[j].cref = cr;
             }
         }
     }
@@ -1766,6 +4367,19 @@ void Solver::relocAll(ClauseAllocator &to)
 
     learnts.shrink(i - j);
 
+    // Clauses waiting for subsumption:
+    //
+    for (i = j = 0; i < subsumption_queue.size(); i++)
+    {
+        if (!isRemoved(subsumption_queue[i]))
+        {
+            ca.reloc(subsumption_queue[i], to);
+            subsumption_queue[j++] = subsumption_queue[i];
+        }
+    }
+
+    subsumption_queue.shrink(i - j);
+
     // All original:
     //
     for (i = j = 0; i < clauses.size(); i++)
@@ -1789,8 +4403,22 @@ void Solver::garbageCollect()
     relocAll(to);
     if (verbosity >= 2)
     {
-        printf("|  Garbage collection:   %12d bytes => %12d bytes             |\n",
-               ca.size() * ClauseAllocator::Unit_Size, to.size() * ClauseAllocator::Unit_Size);
+        printf("|  Garbage collection:   %12" PRIu64 " bytes => %12" PRIu64 " bytes             |\n",
+               (uint64_t)ca.size() * ClauseAllocator::Unit_Size, (uint64_t)to.size() * ClauseAllocator::Unit_Size);
+    }
+
+    if (cache_miss_counter >= 0)
+    {
+        // Cache misses per propagation since the previous collection, to compare layouts:
+        uint64_t misses = readCacheMissCounter(cache_miss_counter);
+        if (verbosity >= 2 && propagations > gc_propagations)
+        {
+            printf("|  Cache misses:         %12.2f /propagation since the last collection     |\n",
+                   (misses - gc_misses) / (double)(propagations - gc_propagations));
+        }
+
+        gc_misses = misses;
+        gc_propagations = propagations;
     }
 
     to.moveTo(ca);
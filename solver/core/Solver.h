@@ -21,28 +21,97 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 #ifndef Minisat_Solver_h
 #define Minisat_Solver_h
 
+#include <atomic>
+
 #include "solver/mtl/Vec.h"
 #include "solver/mtl/Heap.h"
+#include "solver/mtl/DaryHeap.h"
+#include "solver/mtl/VmtfQueue.h"
 #include "solver/mtl/Alg.h"
 #include "solver/mtl/IntMap.h"
 #include "solver/utils/Options.h"
 #include "solver/core/SolverTypes.h"
 #include "solver/core/Config.h"
+#include "solver/core/Heuristics.h"
 
 #include "core/source/structures/parser.hpp"
 
 namespace Minisat
 {
+    class LocalSearch;
+    class ClauseExchange;
+
+    //=================================================================================================
+    // SolverConfig -- the mode of operation of a solver:
+    //
+    // A solver copies its configuration when it is constructed and never reads the command-line
+    // options itself, so solvers with different configurations can run side by side. The default
+    // configuration takes the values of the options (their defaults unless 'parseOptions()' was
+    // called).
+
+    struct SolverConfig
+    {
+        SolverConfig();
+
+        int verbosity;
+        double var_decay;
+        double clause_decay;
+        double random_var_freq;
+        double random_seed;
+        bool luby_restart;
+        int ccmin_mode;      // Controls conflict clause minimization (0=none, 1=basic, 2=deep).
+        int bin_min_glue;    // Minimize learnt clauses up to this glue with binary clauses (0=never).
+        int decision_order;  // Controls the decision order (0=activity heap, 1=VMTF queue).
+        int chrono;          // Backtrack chronologically if a backjump would undo more than this number of levels (-1=never).
+        int phase_saving;    // Controls the level of phase saving (0=none, 1=limited, 2=full).
+        bool reuse_trail;    // Keep the decision levels that would be re-decided identically on restart.
+        bool gc_locality;    // Lay out clauses in the order propagation visits them when collecting garbage.
+        bool simd_watch_search; // Search for new watches in long clauses with AVX2.
+        int rephase_int;     // Base number of conflicts between resets of the saved phases (0=never).
+        bool target_phase;   // Decide on the phases of the longest conflict-free trail.
+        int branching;       // Branching heuristic (0=decision order, 1=back propagation, 2=J-frontier activity, see Heuristics.h).
+        bool bp_activity;    // Break distance ties of the back propagation by activity.
+        int bp_xor;          // XOR gates in the back propagation (0=no preference, 1=prefer, 2=avoid).
+        int csat_start;      // Restarts made with the circuit branching heuristic before the decision order takes over (0=never).
+        int polarity_init;   // Initial polarities derived from the circuit (0=none, 1=max probability, 2=max back propagation).
+        bool podem;          // Decide only on circuit inputs, backtraced from an unjustified J-frontier gate (with back propagation).
+        int inprocess_int;   // Base number of conflicts between inprocessing rounds (0=never).
+        int ls_int;          // Base number of conflicts between local search rounds on the circuit inputs (0=never).
+        int ls_flips;        // Number of flips of each local search round.
+        int share_glue;      // Initial glue limit of the learnt clauses exported to 'exchange', adapted to the export rate (0=never).
+        int share_size;      // Size limit of the learnt clauses exported to 'exchange'.
+        double inprocess_effort; // Propagation budget of an inprocessing technique relative to the search propagations since the last round.
+        double subsume_time; // Time limit in seconds of each subsumption pass (0=never).
+        int64_t subsume_steps; // Step limit of each subsumption pass (0=none), normally reached before the time limit.
+        bool use_probe;      // Probe for failed literals when inprocessing.
+        bool use_substitute; // Substitute equivalent literals when inprocessing.
+        bool use_vivify;     // Vivify learnt clauses when inprocessing.
+        int use_elim;        // Eliminate the variables that are not frozen before solving (0=never, 1=always, 2=only with 'branch_order').
+        int grow;            // Allow a variable elimination step to grow by a number of clauses (default to zero).
+        int clause_lim;      // Variables are not eliminated if it produces a resolvent with a length above this limit (-1=no limit).
+        bool rnd_pol;        // Use random polarities for branching heuristics.
+        bool rnd_init_act;   // Initialize variable activities with a small random value.
+        double garbage_frac; // The fraction of wasted memory allowed before a garbage collection is triggered.
+        int min_learnts_lim; // Minimum number to set the learnts limit to.
+
+        int restart_first;        // The initial restart limit.                                                                (default 100)
+        double restart_inc;       // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
+        double learntsize_factor; // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
+        double learntsize_inc;    // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
+
+        int learntsize_adjust_start_confl;
+        double learntsize_adjust_inc;
+    };
 
     //=================================================================================================
     // Solver -- the main class:
 
-    class Solver
+    class Solver : public SolverConfig
     {
     public:
         // Constructor/Destructor:
         //
-        Solver();
+        explicit Solver(const SolverConfig &config = SolverConfig());
         virtual ~Solver();
 
         // Problem specification:
@@ -71,6 +140,7 @@ namespace Minisat
         bool okay() const;                           // FALSE means solver is in a conflicting state
 
         bool implies(const vec<Lit> &assumps, vec<Lit> &out);
+        bool lookaheadCubes(int max_cubes, vec<vec<Lit> > &cubes); // Split the problem into cubes by lookahead. FALSE means the problem is unsatisfiable.
 
         // Iterate over clauses and top-level assignments:
         ClauseIterator clausesBegin() const;
@@ -92,6 +162,8 @@ namespace Minisat
         //
         void setPolarity(Var v, lbool b);   // Declare which polarity the decision heuristic should use for a variable. Requires mode 'polarity_user'.
         void setDecisionVar(Var v, bool b); // Declare if a variable should be eligible for selection in the decision heuristic.
+        void setFrozen(Var v, bool b);      // If a variable is frozen it will not be eliminated or substituted.
+        bool isEliminated(Var v) const;
 
         // Read state:
         //
@@ -126,39 +198,30 @@ namespace Minisat
         LSet conflict;    // If problem is unsatisfiable (possibly under assumptions),
                           // this vector represent the final conflict clause expressed in the assumptions.
 
-        // Mode of operation:
-        //
-        int verbosity;
-        double var_decay;
-        double clause_decay;
-        double random_var_freq;
-        double random_seed;
-        bool luby_restart;
-        int ccmin_mode;      // Controls conflict clause minimization (0=none, 1=basic, 2=deep).
-        int phase_saving;    // Controls the level of phase saving (0=none, 1=limited, 2=full).
-        bool rnd_pol;        // Use random polarities for branching heuristics.
-        bool rnd_init_act;   // Initialize variable activities with a small random value.
-        double garbage_frac; // The fraction of wasted memory allowed before a garbage collection is triggered.
-        int min_learnts_lim; // Minimum number to set the learnts limit to.
-
-        int restart_first;        // The initial restart limit.                                                                (default 100)
-        double restart_inc;       // The factor with which the restart limit is multiplied in each restart.                    (default 1.5)
-        double learntsize_factor; // The intitial limit for learnt clauses is a factor of the original clauses.                (default 1 / 3)
-        double learntsize_inc;    // The limit for learnt clauses is multiplied with this factor each restart.                 (default 1.1)
-
-        int learntsize_adjust_start_confl;
-        double learntsize_adjust_inc;
-
         // Statistics: (read-only member variable)
         //
-        uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts;
+        uint64_t solves, starts, decisions, rnd_decisions, propagations, conflicts, chrono_backtracks;
         uint64_t dec_vars, num_clauses, num_learnts, clauses_literals, learnts_literals, max_literals, tot_literals;
+        uint64_t reused_levels, rephases, inprocessings;
+        uint64_t cache_misses; // Hardware cache misses while solving (if they can be counted).
+        uint64_t bin_min_literals; // Learnt clause literals removed by binary clauses.
+        uint64_t subsumed_clauses, strengthened_clauses, eliminated_vars;
+        uint64_t probe_units, probe_hbrs; // Units and hyper-binary resolvents found by probing.
+        uint64_t substituted_vars;
+        uint64_t podem_decisions; // Decisions on circuit inputs found by backtracing.
+        uint64_t shared_exported, shared_imported, shared_useful; // Clauses exchanged (useful: imported and used in a conflict).
+        uint64_t ls_calls, ls_flips_total; // Local search rounds and their flips.
 
         // Circuit-SAT:
         //
         std::shared_ptr<csat::DAG> csat_instance;
         bool verifySolution();
 
+        // Clause sharing:
+        //
+        ClauseExchange *exchange; // Short learnt clauses are exchanged with other solvers through this (if not NULL).
+        int exchange_id;          // The producer id of this solver in 'exchange'.
+
     protected:
         // Helper structures:
         //
@@ -173,7 +236,12 @@ namespace Minisat
             return d;
         }
 
-        struct Watcher
+        // With WIDE_CLAUSE_REFS the watcher is packed to 12 bytes instead of being padded to 16:
+        struct
+#ifdef WIDE_CLAUSE_REFS
+            __attribute__((packed, aligned(4)))
+#endif
+            Watcher
         {
             CRef cref;
             Lit blocker;
@@ -182,6 +250,67 @@ namespace Minisat
             bool operator!=(const Watcher &w) const { return cref != w.cref; }
         };
 
+#ifdef PACKED_VAR_STATE
+        // The per-variable state touched by propagation and conflict analysis, packed into one record
+        // (16 bytes) so that it costs a single cache line per variable. 'assigns', 'vardata', 'seen' and
+        // 'polarity' are views of its fields with the interface of the separate maps:
+        struct alignas(16) VarState
+        {
+            CRef reason;
+            int level;
+            lbool value;
+            char seen;
+            char polarity;
+        };
+
+        template <class T, T VarState::*field>
+        class VarStateField
+        {
+            VMap<VarState> &states;
+
+        public:
+            explicit VarStateField(VMap<VarState> &s) : states(s) {}
+            T &operator[](Var v) { return states[v].*field; }
+            const T &operator[](Var v) const { return states[v].*field; }
+            void insert(Var v, T val)
+            {
+                states.reserve(v);
+                states[v].*field = val;
+            }
+        };
+
+        struct VarDataRef
+        {
+            CRef &reason;
+            int &level;
+            VarDataRef &operator=(const VarData &d)
+            {
+                reason = d.reason;
+                level = d.level;
+                return *this;
+            }
+        };
+
+        class VarDataView
+        {
+            VMap<VarState> &states;
+
+        public:
+            explicit VarDataView(VMap<VarState> &s) : states(s) {}
+            VarDataRef operator[](Var v)
+            {
+                VarState &s = states[v];
+                return VarDataRef{s.reason, s.level};
+            }
+            VarData operator[](Var v) const { return mkVarData(states[v].reason, states[v].level); }
+            void insert(Var v, const VarData &d)
+            {
+                states.reserve(v);
+                operator[](v) = d;
+            }
+        };
+#endif
+
         struct WatcherDeleted
         {
             const ClauseAllocator &ca;
@@ -196,6 +325,20 @@ namespace Minisat
             VarOrderLt(const IntMap<Var, double> &act) : activity(act) {}
         };
 
+        struct VarOrderKey
+        {
+            const IntMap<Var, double> &activity;
+            double operator()(Var x) const { return activity[x]; }
+            VarOrderKey(const IntMap<Var, double> &act) : activity(act) {}
+        };
+
+        struct ReduceDBKey
+        {
+            float activity;
+            CRef cref;
+            bool operator<(const ReduceDBKey &k) const { return activity < k.activity; }
+        };
+
         struct ShrinkStackElem
         {
             uint32_t i;
@@ -212,20 +355,40 @@ namespace Minisat
         vec<Lit> assumptions; // Current set of assumptions provided to solve by the user.
 
         VMap<double> activity; // A heuristic measurement of the activity of a variable.
+#ifdef PACKED_VAR_STATE
+        VMap<VarState> var_state;                                // Storage of the four views below.
+        VarStateField<lbool, &VarState::value> assigns;          // The current assignments.
+        VarStateField<char, &VarState::polarity> polarity;       // The preferred polarity of each variable.
+#else
         VMap<lbool> assigns;   // The current assignments.
         VMap<char> polarity;   // The preferred polarity of each variable.
-
-#if defined CSAT_HEURISTIC_START && RESET_POLARITY && (defined POLARITY_INIT_MAXPROB || defined POLARITY_INIT_MAXBACKPROP)
-        VMap<char> polarity_copy;
 #endif
+        VMap<lbool> target_polarity; // Polarity on the longest conflict-free trail since the last rephase (l_Undef if not on it).
+        VMap<lbool> best_polarity;   // Polarity on the longest conflict-free trail since the last rephase to it.
+        int target_assigned;         // Length of the trail 'target_polarity' was taken from.
+        int best_assigned;           // Length of the trail 'best_polarity' was taken from.
+        uint64_t next_rephase;       // Number of conflicts at which to rephase next.
+        std::unique_ptr<LocalSearch> local_search; // Local search on the circuit inputs (created on first use).
+        uint64_t next_local_search;  // Number of conflicts at which to run the next local search round.
+
+        VMap<char> polarity_copy;    // The initial polarities, restored when the circuit start ends (with RESET_POLARITY).
 
         VMap<lbool> user_pol;  // The users preferred polarity of each variable.
         VMap<char> decision;   // Declares if a variable is eligible for selection in the decision heuristic.
+#ifdef PACKED_VAR_STATE
+        VarDataView vardata;   // Stores reason and level for each variable.
+#else
         VMap<VarData> vardata; // Stores reason and level for each variable.
+#endif
         OccLists<Lit, vec<Watcher>, WatcherDeleted, MkIndexLit>
             watches; // 'watches[lit]' is a list of constraints watching 'lit' (will go there if literal becomes true).
 
+#ifdef DARY_ORDER_HEAP
+        DaryHeap<Var, VarOrderKey> order_heap; // A priority queue of variables ordered with respect to the variable activity.
+#else
         Heap<Var, VarOrderLt> order_heap; // A priority queue of variables ordered with respect to the variable activity.
+#endif
+        VmtfQueue<Var> vmtf_queue;        // Variables ordered by the time they were last bumped (used if 'decision_order == 1').
 
         bool ok;                  // If FALSE, the constraints are already unsatisfiable. No part of the solver state may be used!
         double cla_inc;           // Amount to bump next clause with.
@@ -244,10 +407,87 @@ namespace Minisat
         // Temporaries (to reduce allocation overhead). Each variable is prefixed by the method in which it is
         // used, exept 'seen' wich is used in several places.
         //
+#ifdef PACKED_VAR_STATE
+        VarStateField<char, &VarState::seen> seen;
+#else
         VMap<char> seen;
+#endif
         vec<ShrinkStackElem> analyze_stack;
         vec<Lit> analyze_toclear;
         vec<Lit> add_tmp;
+        vec<Var> vmtf_bumped;
+        vec<ReduceDBKey> reduce_keys;
+        VMap<uint32_t> var_stamp;  // Marks of variables (current if equal to 'stamp').
+        vec<uint32_t> level_stamp; // Marks of decision levels (current if equal to 'stamp').
+        uint32_t stamp;
+
+        // Inprocessing techniques run at level 0 restarts (in order of registration):
+        //
+        struct Technique
+        {
+            const char *name;
+            bool (Solver::*run)(int64_t budget); // Returns FALSE if the clauses were found unsatisfiable.
+            bool enabled;
+            uint64_t calls;
+            int64_t clauses_removed, literals_removed;
+            double time;
+        };
+        vec<Technique> techniques;
+
+        // Subsumption:
+        //
+        struct Occurrence
+        {
+            CRef cref;
+            uint32_t abs; // Abstraction of the clause when the occurrence lists were built.
+        };
+        vec<vec<Occurrence> > occurs;  // Clauses containing each variable (only during 'subsume()').
+        vec<CRef> subsumption_queue;   // Clauses still to be checked for subsumption.
+        bool preprocessed;             // Have the original clauses been subsumed and eliminated?
+
+        // Variable elimination:
+        //
+        struct ElimLt
+        {
+            const vec<vec<Occurrence> > &occs;
+            bool operator()(Var x, Var y) const { return occs[x].size() < occs[y].size(); }
+            ElimLt(const vec<vec<Occurrence> > &o) : occs(o) {}
+        };
+        VMap<char> frozen;        // Variables that must not be eliminated (see 'eliminate()').
+        VMap<char> eliminated;
+        vec<uint32_t> elimclauses; // Elimination stack: clauses of the eliminated variables, each followed by its size.
+
+        // Equivalent-literal substitution:
+        //
+        struct SccFrame
+        {
+            Lit lit;
+            int pos; // Position in the watches of 'lit'.
+            SccFrame(Lit l) : lit(l), pos(0) {}
+        };
+        VMap<Lit> representative;    // Literal equivalent to the positive literal of each variable (itself if not substituted).
+        vec<vec<Var> > substituted;  // Variables substituted by each representative.
+        uint64_t next_inprocess; // Number of conflicts at which to run the next inprocessing round.
+        uint64_t inprocess_props; // Number of propagations at the end of the last round.
+
+        static const int simd_min_size = 18;        // Minimum clause size for the AVX2 watch search (two full vectors).
+        static const int bin_min_max_size = 30;     // Maximum learnt clause size for binary minimization.
+        static const int probe_min_fanout = 4;      // Minimum number of users of a gate to probe it.
+        static const int probe_max_hbrs = 1000;     // Maximum number of hyper-binary resolvents learnt by each probing pass.
+        static const int lookahead_candidates = 32; // Number of variables tried by the lookahead for a split.
+        static const int share_period = 1000;       // Conflicts between adaptations of the export glue limit.
+        static const int share_target = 20;         // Exported clauses per period the glue limit is adapted to.
+        static const int share_filter_bits = 14;    // Log2 of the number of hashes kept of the shared clauses.
+
+        uint64_t exchange_cursor;    // The next clause to read from 'exchange'.
+        int export_glue;             // Current glue limit of the exported clauses.
+        uint64_t export_window;      // Clauses exported since the last adaptation.
+        uint64_t next_share_adjust;  // Number of conflicts at which to adapt the glue limit.
+        vec<uint64_t> shared_hashes; // Hashes of recently exported or imported clauses, by their low bits.
+
+        int cache_miss_counter;   // Handle of the cache-miss counter (-1 if not counting).
+        uint64_t gc_misses;       // Cache misses counted at the last garbage collection.
+        uint64_t gc_propagations; // Propagations made until the last garbage collection.
 
         double max_learnts;
         double learntsize_adjust_confl;
@@ -257,31 +497,62 @@ namespace Minisat
         //
         int64_t conflict_budget;    // -1 means no budget.
         int64_t propagation_budget; // -1 means no budget.
-        bool asynch_interrupt;
+        std::atomic<bool> asynch_interrupt;
 
         // Main internal methods:
         //
         void insertVarOrder(Var x);                                       // Insert a variable in the decision order priority queue.
-        Lit pickBranchLit();                                              // Return the next decision variable.
+        template <class B> Lit pickBranchLit();                           // Return the next decision variable.
+        Var pickOrderVar();                                               // Return the next unassigned decision variable from the decision order.
+        bool branchPolarity(Var v) const;                                 // The polarity to decide 'v' with (target or saved phase).
+        void updatePhases(int consistent);                                // Save the phases of 'trail[0..consistent)' if it is a new longest trail.
+        void rephase();                                                   // Reset the saved phases according to the rephasing schedule.
+        void localSearch();                                               // Exchange the saved phases with a local search on the circuit inputs.
         void newDecisionLevel();                                          // Begins a new decision level.
         void uncheckedEnqueue(Lit p, CRef from = CRef_Undef);             // Enqueue a literal. Assumes value of literal is undefined.
+        void uncheckedEnqueue(Lit p, int level, CRef from);               // Enqueue a literal at a given (possibly lower than current) level.
         bool enqueue(Lit p, CRef from = CRef_Undef);                      // Test if fact 'p' contradicts current state, enqueue otherwise.
         CRef propagate();                                                 // Perform unit propagation. Returns possibly conflicting clause.
         void cancelUntil(int level);                                      // Backtrack until a certain level.
+        template <class B> int reusableTrailLevel();                      // The number of decision levels a restart would rebuild identically.
+        template <class B> bool decidedBefore(Var x, Var next) const;     // Would the branching heuristic pick 'x' before 'next'?
+        int findConflictLevel(CRef confl, bool &single);                 // Find the highest level in a conflict clause and move it to 'c[0]'.
         void analyze(CRef confl, vec<Lit> &out_learnt, int &out_btlevel); // (bt = backtrack)
         void analyzeFinal(Lit p, LSet &out_conflict);                     // COULD THIS BE IMPLEMENTED BY THE ORDINARIY "analyze" BY SOME REASONABLE GENERALIZATION?
         bool litRedundant(Lit p);                                         // (helper method for 'analyze()')
+        void binaryMinimize(vec<Lit> &out_learnt);                        // (helper method for 'analyze()')
+        int computeLBD(const vec<Lit> &lits);                             // Number of distinct decision levels in 'lits'.
+        uint32_t nextStamp();                                             // A fresh value for 'var_stamp'/'level_stamp'.
         lbool search(int nof_conflicts);                                  // Search for a given number of conflicts.
+        template <class B> lbool searchWith(int nof_conflicts);           // (instance of 'search()' for a branching policy)
+        void endCircuitStart();                                           // Switch from the circuit heuristic to the decision order.
         lbool solve_();                                                   // Main solve method (assumptions given in 'assumptions').
         void reduceDB();                                                  // Reduce the set of learnt clauses.
         void removeSatisfied(vec<CRef> &cs);                              // Shrink 'cs' to contain only non-satisfied clauses.
         void rebuildOrderHeap();
+        void addTechnique(const char *name, bool (Solver::*run)(int64_t), bool enabled); // Register an inprocessing technique.
+        bool inprocess();                                                                // Run an inprocessing round (at level 0).
+        void shareLearnt(const vec<Lit> &lits);                                          // Export a learnt clause if it is short enough.
+        bool importClauses();                                                            // Add the clauses of the other solvers (at level 0).
+        bool sharedBefore(const vec<Lit> &lits);                                         // Record a shared clause, TRUE if it was recorded recently.
+        bool probe(int64_t budget);                                                      // Inprocessing: failed-literal probing with hyper-binary resolution.
+        bool substituteEquivalences(int64_t budget);                                     // Inprocessing: substitute equivalent literals.
+        bool vivifyLearnts(int64_t budget);                                              // Inprocessing: shorten the most active learnt clauses.
+        bool subsumeLearnts(int64_t budget);                                             // Inprocessing: subsumption of the new learnt clauses.
+        bool subsume(double time_limit, int64_t step_limit);                             // Subsumption and strengthening with the queued clauses.
+        void buildOccurrences(const vec<CRef> &cs, bool clear = true);                   // Add the clauses 'cs' to 'occurs'.
+        bool eliminate();                                                                // Bounded variable elimination of the variables that are not frozen.
+        bool eliminateVar(Var v);
+        bool merge(const Clause &_ps, const Clause &_qs, Var v, vec<Lit> &out_clause);
+        bool addResolvent(vec<Lit> &ps);
+        void extendModel();                                                              // Assign the eliminated variables in 'model'.
 
         // Maintaining Variable/Clause activity:
         //
         void varDecayActivity();                 // Decay all variables with the specified factor. Implemented by increasing the 'bump' value instead.
         void varBumpActivity(Var v, double inc); // Increase a variable with the current 'bump' value.
         void varBumpActivity(Var v);             // Increase a variable with the current 'bump' value.
+        void vmtfBumpVars();                     // Move the variables bumped in the last conflict to the front of the VMTF queue.
         void claDecayActivity();                 // Decay all clauses with the specified factor. Implemented by increasing the 'bump' value instead.
         void claBumpActivity(Clause &c);         // Increase a clause with the current 'bump' value.
 
@@ -324,19 +595,20 @@ namespace Minisat
 
         // Circuit-SAT:
         //
-#if defined BACKPROP || defined JFRONTIERS_ACTIVITY
-        std::set<Var> jFrontiers;
-        Var pickBranchjFParent();
-#endif
+        std::set<Var> jFrontiers; // Assigned gates, with unassigned operands unless stale (kept unless 'branching' is 0).
+        template <class B> Var pickBranchjFParent();
+        void unassignJFrontier(Var x);
 
-#if defined POLARITY_INIT_MAXPROB || defined POLARITY_INIT_MAXBACKPROP
         void setDefaultPolarities();
-#endif
+        void circuitPolarities(bool max_prob);
 
-#ifdef BACKPROP
-        std::vector<int> distance_to_output;
+        std::vector<int> distance_to_output; // Shortest distance of each gate to an output (the least of its class for a representative).
         void countDistances();
-#endif
+
+        std::vector<int> controllability[2]; // SCOAP combinational 0/1-controllability of each gate.
+        void computeControllability();
+        bool justified(Var gate);            // Is the value of an assigned gate implied by its assigned operands?
+        Lit pickBranchPodem();               // Backtrace from an unjustified J-frontier to a circuit input.
     };
 
     //=================================================================================================
@@ -347,12 +619,45 @@ namespace Minisat
 
     inline void Solver::insertVarOrder(Var x)
     {
-        if (!order_heap.inHeap(x) && decision[x])
+        if (decision_order == 1)
+        {
+            if (decision[x])
+            {
+                vmtf_queue.updateSearch(x);
+            }
+        }
+        else if (!order_heap.inHeap(x) && decision[x])
         {
             order_heap.insert(x);
         }
     }
 
+    inline uint32_t Solver::nextStamp()
+    {
+        // Two values are used per stamp (see 'binaryMinimize()'), clear all marks on wrap-around:
+        if ((stamp += 2) < 2)
+        {
+            for (Var v = 0; v < nVars(); v++)
+            {
+                var_stamp[v] = 0;
+            }
+
+            for (int i = 0; i < level_stamp.size(); i++)
+            {
+                level_stamp[i] = 0;
+            }
+
+            stamp = 2;
+        }
+
+        return stamp;
+    }
+
+    inline bool Solver::branchPolarity(Var v) const
+    {
+        return target_phase && target_polarity[v] != l_Undef ? target_polarity[v] == l_True : polarity[v];
+    }
+
     inline void Solver::varDecayActivity() { var_inc *= (1 / var_decay); }
     inline void Solver::varBumpActivity(Var v) { varBumpActivity(v, var_inc); }
     inline void Solver::varBumpActivity(Var v, double inc)
@@ -364,12 +669,19 @@ namespace Minisat
             {
                 activity[i] *= 1e-100;
             }
+#ifdef DARY_ORDER_HEAP
+            order_heap.scaleKeys(1e-100);
+#endif
 
             var_inc *= 1e-100;
         }
 
-        // Update order_heap with respect to new activity:
-        if (order_heap.inHeap(v))
+        // Update the decision order with respect to new activity:
+        if (decision_order == 1)
+        {
+            vmtf_bumped.push(v);
+        }
+        else if (order_heap.inHeap(v))
         {
             order_heap.decrease(v);
         }
@@ -394,6 +706,8 @@ namespace Minisat
             garbageCollect();
     }
 
+    inline void Solver::uncheckedEnqueue(Lit p, CRef from) { uncheckedEnqueue(p, decisionLevel(), from); }
+
     // NOTE: enqueue does not set the ok flag! (only public methods do)
     inline bool Solver::enqueue(Lit p, CRef from) { return value(p) != l_Undef ? value(p) != l_False : (uncheckedEnqueue(p, from), true); }
     inline bool Solver::addClause(const vec<Lit> &ps)
@@ -454,6 +768,8 @@ namespace Minisat
     // TODO: nFreeVars() is not quite correct, try to calculate right instead of adapting it like below:
     inline int Solver::nFreeVars() const { return (int)dec_vars - (trail_lim.size() == 0 ? trail.size() : trail_lim[0]); }
     inline void Solver::setPolarity(Var v, lbool b) { user_pol[v] = b; }
+    inline void Solver::setFrozen(Var v, bool b) { frozen[v] = (char)b; }
+    inline bool Solver::isEliminated(Var v) const { return eliminated[v]; }
     inline void Solver::setDecisionVar(Var v, bool b)
     {
         if (b && !decision[v])
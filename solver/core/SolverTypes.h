@@ -170,7 +170,15 @@ namespace Minisat
     // Clause -- a simple class for representing a clause:
 
     class Clause;
-    typedef RegionAllocator<uint32_t>::Ref CRef;
+
+    // Clause references index 32-bit words of the clause arena. They are 32 bits wide by default, which
+    // limits the arena to 16 GB; building with WIDE_CLAUSE_REFS makes them 64 bits wide.
+#ifdef WIDE_CLAUSE_REFS
+    typedef RegionAllocator<uint32_t, uint64_t> ClauseRegion;
+#else
+    typedef RegionAllocator<uint32_t> ClauseRegion;
+#endif
+    typedef ClauseRegion::Ref CRef;
 
     class Clause
     {
@@ -180,25 +188,27 @@ namespace Minisat
             unsigned learnt : 1;
             unsigned has_extra : 1;
             unsigned reloced : 1;
-            unsigned size : 27;
+            unsigned imported : 1;
+            unsigned size : 26; // See 'max_size'.
         } header;
         union
         {
             Lit lit;
             float act;
             uint32_t abs;
-            CRef rel;
-        } data[0];
+        } data[0]; // NOTE: a relocation is stored in the first one or two words (see 'relocate()').
 
         friend class ClauseAllocator;
 
         // NOTE: This constructor cannot be used directly (doesn't allocate enough memory).
         Clause(const vec<Lit> &ps, bool use_extra, bool learnt)
         {
+            assert(ps.size() <= max_size);
             header.mark = 0;
             header.learnt = learnt;
             header.has_extra = use_extra;
             header.reloced = 0;
+            header.imported = 0;
             header.size = ps.size();
 
             for (int i = 0; i < ps.size(); i++)
@@ -244,6 +254,8 @@ namespace Minisat
         }
 
     public:
+        static const int max_size = (1 << 26) - 1; // The longest clause the header can hold.
+
         void calcAbstraction()
         {
             assert(header.has_extra);
@@ -272,14 +284,27 @@ namespace Minisat
         bool has_extra() const { return header.has_extra; }
         uint32_t mark() const { return header.mark; }
         void mark(uint32_t m) { header.mark = m; }
+        bool imported() const { return header.imported; } // Learnt by another solver and not used in a conflict yet.
+        void imported(bool b) { header.imported = b; }
         const Lit &last() const { return data[header.size - 1].lit; }
 
         bool reloced() const { return header.reloced; }
-        CRef relocation() const { return data[0].rel; }
+        CRef relocation() const
+        {
+#ifdef WIDE_CLAUSE_REFS
+            return (CRef)data[0].abs | ((CRef)data[1].abs << 32);
+#else
+            return data[0].abs;
+#endif
+        }
         void relocate(CRef c)
         {
             header.reloced = 1;
-            data[0].rel = c;
+            data[0].abs = (uint32_t)c;
+#ifdef WIDE_CLAUSE_REFS
+            assert(size() + has_extra() >= 2);
+            data[1].abs = (uint32_t)(c >> 32);
+#endif
         }
 
         // NOTE: somewhat unsafe to change the clause in-place! Must manually call 'calcAbstraction' afterwards for
@@ -300,16 +325,17 @@ namespace Minisat
         }
 
         Lit subsumes(const Clause &other) const;
+        Lit subsumes(const Clause &other, uint32_t abs, uint32_t other_abs) const;
         void strengthen(Lit p);
     };
 
     //=================================================================================================
     // ClauseAllocator -- a simple class for allocating memory for clauses:
 
-    const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+    const CRef CRef_Undef = ClauseRegion::Ref_Undef;
     class ClauseAllocator
     {
-        RegionAllocator<uint32_t> ra;
+        ClauseRegion ra;
 
         static uint32_t clauseWord32Size(int size, bool has_extra)
         {
@@ -319,12 +345,12 @@ namespace Minisat
     public:
         enum
         {
-            Unit_Size = RegionAllocator<uint32_t>::Unit_Size
+            Unit_Size = ClauseRegion::Unit_Size
         };
 
         bool extra_clause_field;
 
-        ClauseAllocator(uint32_t start_cap) : ra(start_cap), extra_clause_field(false) {}
+        ClauseAllocator(CRef start_cap) : ra(start_cap), extra_clause_field(false) {}
         ClauseAllocator() : extra_clause_field(false) {}
 
         void moveTo(ClauseAllocator &to)
@@ -352,8 +378,8 @@ namespace Minisat
             return cid;
         }
 
-        uint32_t size() const { return ra.size(); }
-        uint32_t wasted() const { return ra.wasted(); }
+        CRef size() const { return ra.size(); }
+        CRef wasted() const { return ra.wasted(); }
 
         // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
         Clause &operator[](CRef r) { return (Clause &)ra[r]; }
@@ -511,7 +537,7 @@ namespace Minisat
     {
         struct CRefHash
         {
-            uint32_t operator()(CRef cr) const { return (uint32_t)cr; }
+            uint32_t operator()(CRef cr) const { return (uint32_t)((uint64_t)cr ^ ((uint64_t)cr >> 32)); }
         };
 
         typedef Map<CRef, T, CRefHash> HashTable;
@@ -561,13 +587,18 @@ namespace Minisat
     |________________________________________________________________________________________________@*/
     inline Lit Clause::subsumes(const Clause &other) const
     {
-        // if (other.size() < size() || (extra.abst & ~other.extra.abst) != 0)
-        // if (other.size() < size() || (!learnt() && !other.learnt() && (extra.abst & ~other.extra.abst) != 0))
         assert(!header.learnt);
         assert(!other.header.learnt);
         assert(header.has_extra);
         assert(other.header.has_extra);
-        if (other.header.size < header.size || (data[header.size].abs & ~other.data[other.header.size].abs) != 0)
+        return subsumes(other, data[header.size].abs, other.data[other.header.size].abs);
+    }
+
+    // As above, but with the abstractions given by the caller (learnt clauses store their activity
+    // instead). The abstraction of 'other' may be a superset of its actual abstraction.
+    inline Lit Clause::subsumes(const Clause &other, uint32_t abs, uint32_t other_abs) const
+    {
+        if (other.header.size < header.size || (abs & ~other_abs) != 0)
         {
             return lit_Error;
         }
@@ -0,0 +1,82 @@
+/**********************************************************************************[WatchSearch.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_WatchSearch_h
+#define Minisat_WatchSearch_h
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "solver/core/SolverTypes.h"
+
+namespace Minisat
+{
+
+    //=================================================================================================
+    // Replacement-watch search -- the position of the first literal from 'k' on that is not false
+    // ('size' if there is none), where 'values' holds the 'lbool' value of each variable in one byte:
+
+    static inline int firstNonFalse(const Lit *lits, int k, int size, const uint8_t *values)
+    {
+        for (; k < size; k++)
+        {
+            if ((values[var(lits[k])] ^ (uint8_t)sign(lits[k])) != 1)
+            {
+                return k;
+            }
+        }
+
+        return size;
+    }
+
+    // With AVX2: for 8 literals at a time, gather the aligned 32-bit words of 'values' that hold
+    // their values, shift the value bytes down and compare them (xor the sign) with 'l_False'. Only
+    // used for the separate 'assigns' map, where a value is one byte. 'values' must be readable up
+    // to the next multiple of 4 bytes ('Solver::newVar()' pads 'assigns' to it):
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(PACKED_VAR_STATE)
+    static inline bool simdSupported() { return __builtin_cpu_supports("avx2"); }
+
+    __attribute__((target("avx2"))) static inline int firstNonFalseAVX2(const Lit *lits, int k, int size, const uint8_t *values)
+    {
+        const __m256i ones = _mm256_set1_epi32(1);
+        const __m256i three = _mm256_set1_epi32(3);
+        const __m256i low_byte = _mm256_set1_epi32(0xFF);
+        for (; k + 8 <= size; k += 8)
+        {
+            __m256i x = _mm256_loadu_si256((const __m256i *)(lits + k));
+            __m256i v = _mm256_srli_epi32(x, 1);
+            __m256i word = _mm256_i32gather_epi32((const int *)values, _mm256_andnot_si256(three, v), 1);
+            __m256i value = _mm256_and_si256(_mm256_srlv_epi32(word, _mm256_slli_epi32(_mm256_and_si256(v, three), 3)), low_byte);
+            value = _mm256_xor_si256(value, _mm256_and_si256(x, ones));
+            int non_false = ~_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(value, ones))) & 0xFF;
+            if (non_false != 0)
+            {
+                return k + __builtin_ctz(non_false);
+            }
+        }
+
+        return firstNonFalse(lits, k, size, values);
+    }
+#else
+    static inline bool simdSupported() { return false; }
+#endif
+
+    //=================================================================================================
+}
+
+#endif
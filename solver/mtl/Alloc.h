@@ -27,34 +27,34 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 namespace Minisat {
 
 //=================================================================================================
-// Simple Region-based memory allocator:
+// Simple Region-based memory allocator. References are indices of type 'R' counted in units of 'T',
+// which bounds the size of the region to 'sizeof(T) * 2^(8*sizeof(R))' bytes. If possible the region
+// lives in reserved address space of that size (see 'xreserve'), so growing it never copies:
 
-template<class T>
+template<class T, class R = uint32_t>
 class RegionAllocator
 {
-    T*        memory;
-    uint32_t  sz;
-    uint32_t  cap;
-    uint32_t  wasted_;
+    T*  memory;
+    R   sz;
+    R   cap;
+    R   wasted_;
+    size_t reserved;  // Size of the reserved address space (0 if allocated with 'xrealloc').
 
-    void capacity(uint32_t min_cap);
+    void capacity(R min_cap);
+    void release();
 
  public:
     // TODO: make this a class for better type-checking?
-    typedef uint32_t Ref;
-    enum { Ref_Undef = UINT32_MAX };
+    typedef R Ref;
+    static constexpr Ref Ref_Undef = ~(Ref)0;
     enum { Unit_Size = sizeof(T) };
 
-    explicit RegionAllocator(uint32_t start_cap = 1024*1024) : memory(NULL), sz(0), cap(0), wasted_(0){ capacity(start_cap); }
-    ~RegionAllocator()
-    {
-        if (memory != NULL)
-            ::free(memory);
-    }
+    explicit RegionAllocator(Ref start_cap = 1024*1024) : memory(NULL), sz(0), cap(0), wasted_(0), reserved(0){ capacity(start_cap); }
+    ~RegionAllocator() { release(); }
 
 
-    uint32_t size      () const      { return sz; }
-    uint32_t wasted    () const      { return wasted_; }
+    Ref      size      () const      { return sz; }
+    Ref      wasted    () const      { return wasted_; }
 
     Ref      alloc     (int size); 
     void     free      (int size)    { wasted_ += size; }
@@ -69,31 +69,33 @@ class RegionAllocator
         return  (Ref)(t - &memory[0]); }
 
     void     moveTo(RegionAllocator& to) {
-        if (to.memory != NULL) ::free(to.memory);
+        to.release();
         to.memory = memory;
         to.sz = sz;
         to.cap = cap;
         to.wasted_ = wasted_;
+        to.reserved = reserved;
 
         memory = NULL;
         sz = cap = wasted_ = 0;
+        reserved = 0;
     }
 
 
 };
 
-template<class T>
-void RegionAllocator<T>::capacity(uint32_t min_cap)
+template<class T, class R>
+void RegionAllocator<T,R>::capacity(R min_cap)
 {
     if (cap >= min_cap) return;
 
-    uint32_t prev_cap = cap;
+    R prev_cap = cap;
     while (cap < min_cap){
         // NOTE: Multiply by a factor (13/8) without causing overflow, then add 2 and make the
         // result even by clearing the least significant bit. The resulting sequence of capacities
         // is carefully chosen to hit a maximum capacity that is close to the '2^32-1' limit when
         // using 'uint32_t' as indices so that as much as possible of this space can be used.
-        uint32_t delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
+        R delta = ((cap >> 1) + (cap >> 3) + 2) & ~1;
         cap += delta;
 
         if (cap <= prev_cap)
@@ -102,19 +104,41 @@ void RegionAllocator<T>::capacity(uint32_t min_cap)
     // printf(" .. (%p) cap = %u\n", this, cap);
 
     assert(cap > 0);
-    memory = (T*)xrealloc(memory, sizeof(T)*cap);
+    if (memory == NULL){
+        size_t max_size = ((size_t)(Ref)~(Ref)0 < SIZE_MAX / sizeof(T)) ? sizeof(T) * ((size_t)(Ref)~(Ref)0 + 1) : SIZE_MAX / 2;
+        memory = (T*)xreserve(max_size, reserved);
+    }
+
+    if (reserved > 0)
+        xcommit(memory, sizeof(T)*prev_cap, sizeof(T)*cap, reserved);
+    else{
+        memory = (T*)xrealloc(memory, sizeof(T)*cap);
+        xadvise(memory, sizeof(T)*cap);
+    }
+}
+
+
+template<class T, class R>
+void RegionAllocator<T,R>::release()
+{
+    if (memory == NULL) return;
+    if (reserved > 0)
+        xunreserve(memory, reserved);
+    else
+        ::free(memory);
+    memory = NULL;
 }
 
 
-template<class T>
-typename RegionAllocator<T>::Ref
-RegionAllocator<T>::alloc(int size)
+template<class T, class R>
+typename RegionAllocator<T,R>::Ref
+RegionAllocator<T,R>::alloc(int size)
 { 
     // printf("ALLOC called (this = %p, size = %d)\n", this, size); fflush(stdout);
     assert(size > 0);
     capacity(sz + size);
 
-    uint32_t prev_sz = sz;
+    R prev_sz = sz;
     sz += size;
     
     // Handle overflow:
@@ -0,0 +1,222 @@
+/*************************************************************************************[DaryHeap.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_DaryHeap_h
+#define Minisat_DaryHeap_h
+
+#include <string.h>
+
+#include "solver/mtl/XAlloc.h"
+#include "solver/mtl/Vec.h"
+#include "solver/mtl/IntMap.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// A D-ary heap with support for decrease/increase key, with the same interface as 'Heap'. It is a
+// maximum-heap with respect to the key 'KeyOf()(k)', which is copied next to each element so that
+// comparisons need no indirection. The children of an element are stored consecutively and aligned
+// to a cache line (64 bytes, i.e. 4 children for 16-byte entries), so one level of 'percolateDown'
+// touches one line. If keys change, the heap must be told through 'decrease'/'increase'/'update'
+// or, for a uniform scaling of all keys, 'scaleKeys'.
+
+
+template<class K, class KeyOf, int D = 4, class MkIndex = MkIndexDefault<K> >
+class DaryHeap {
+    struct Entry {
+        double key;
+        K      k;
+    };
+
+    enum { Line_Size = 64, Pad = (Line_Size / sizeof(Entry)) - 1 };
+
+    Entry*                mem;      // Allocated entries, the heap starts at 'mem + Pad'
+    Entry*                heap;     // Heap of (key, element) pairs
+    int                   sz;
+    int                   cap;
+    IntMap<K,int,MkIndex> indices;  // Each element's position (index) in the heap
+    KeyOf                 key;
+
+    // Index "traversal" functions
+    static inline int child (int i) { return i*D+1; }
+    static inline int parent(int i) { return (i-1) / D; }
+
+    void capacity(int min_cap)
+    {
+        if (cap >= min_cap) return;
+        int new_cap = cap;
+        while (new_cap < min_cap)
+            new_cap = new_cap < 64 ? 64 : new_cap + (new_cap >> 1);
+
+        // Entries '1 + D*j' (the first children) must start a cache line:
+        size_t bytes = (sizeof(Entry) * (new_cap + Pad) + Line_Size - 1) & ~(size_t)(Line_Size - 1);
+        Entry* m = (Entry*)aligned_alloc(Line_Size, bytes);
+        if (m == NULL)
+            throw OutOfMemoryException();
+        if (sz > 0)
+            memcpy(m + Pad, heap, sizeof(Entry) * sz);
+        ::free(mem);
+        mem  = m;
+        heap = m + Pad;
+        cap  = new_cap;
+        xadvise(mem, bytes);
+    }
+
+    void percolateUp(int i)
+    {
+        Entry x = heap[i];
+        int   p = parent(i);
+
+        while (i != 0 && x.key > heap[p].key){
+            heap[i]            = heap[p];
+            indices[heap[p].k] = i;
+            i                  = p;
+            p                  = parent(p);
+        }
+        heap   [i]   = x;
+        indices[x.k] = i;
+    }
+
+    void percolateDown(int i)
+    {
+        Entry x = heap[i];
+        for (;;){
+            int first = child(i);
+            if (first >= sz) break;
+            int last  = first + D < sz ? first + D : sz;
+            int best  = first;
+            for (int c = first + 1; c < last; c++)
+                if (heap[c].key > heap[best].key)
+                    best = c;
+            if (!(heap[best].key > x.key)) break;
+            heap[i]            = heap[best];
+            indices[heap[i].k] = i;
+            i                  = best;
+        }
+        heap   [i]   = x;
+        indices[x.k] = i;
+    }
+
+  public:
+    DaryHeap(const KeyOf& ko, MkIndex _index = MkIndex()) : mem(NULL), heap(NULL), sz(0), cap(0), indices(_index), key(ko) {}
+   ~DaryHeap() { ::free(mem); }
+
+    int  size      ()          const { return sz; }
+    bool empty     ()          const { return sz == 0; }
+    bool inHeap    (K k)       const { return indices.has(k) && indices[k] >= 0; }
+    int  operator[](int index) const { assert(index < sz); return heap[index].k; }
+
+    // NOTE: named as in 'Heap', where the order is reversed: a "decreased" element has a larger key.
+    void decrease  (K k) { assert(inHeap(k)); heap[indices[k]].key = key(k); percolateUp  (indices[k]); }
+    void increase  (K k) { assert(inHeap(k)); heap[indices[k]].key = key(k); percolateDown(indices[k]); }
+
+
+    // Safe variant of insert/decrease/increase:
+    void update(K k)
+    {
+        if (!inHeap(k))
+            insert(k);
+        else {
+            heap[indices[k]].key = key(k);
+            percolateUp(indices[k]);
+            percolateDown(indices[k]); }
+    }
+
+
+    void insert(K k)
+    {
+        indices.reserve(k, -1);
+        assert(!inHeap(k));
+
+        capacity(sz + 1);
+        heap[sz].key = key(k);
+        heap[sz].k   = k;
+        indices[k]   = sz++;
+        percolateUp(indices[k]);
+    }
+
+
+    void remove(K k)
+    {
+        assert(inHeap(k));
+
+        int k_pos  = indices[k];
+        indices[k] = -1;
+
+        if (k_pos < sz-1){
+            heap[k_pos]            = heap[--sz];
+            indices[heap[k_pos].k] = k_pos;
+            percolateDown(k_pos);
+        }else
+            sz--;
+    }
+
+
+    K removeMin()
+    {
+        K x                = heap[0].k;
+        heap[0]            = heap[--sz];
+        indices[heap[0].k] = 0;
+        indices[x]         = -1;
+        if (sz > 1) percolateDown(0);
+        return x;
+    }
+
+
+    // Multiply all keys by a positive factor (the order is unchanged):
+    void scaleKeys(double factor)
+    {
+        for (int i = 0; i < sz; i++)
+            heap[i].key *= factor;
+    }
+
+
+    // Rebuild the heap from scratch, using the elements in 'ns':
+    void build(const vec<K>& ns) {
+        for (int i = 0; i < sz; i++)
+            indices[heap[i].k] = -1;
+        sz = 0;
+
+        capacity(ns.size());
+        for (int i = 0; i < ns.size(); i++){
+            assert(indices.has(ns[i]));
+            indices[ns[i]] = i;
+            heap[i].key    = key(ns[i]);
+            heap[i].k      = ns[i]; }
+        sz = ns.size();
+
+        for (int i = sz > 1 ? parent(sz - 1) : -1; i >= 0; i--)
+            percolateDown(i);
+    }
+
+    void clear(bool dispose = false)
+    {
+        for (int i = 0; i < sz; i++)
+            indices[heap[i].k] = -1;
+        sz = 0;
+        if (dispose){
+            ::free(mem);
+            mem = heap = NULL;
+            cap = 0; }
+    }
+};
+
+
+//=================================================================================================
+}
+
+#endif
@@ -44,8 +44,8 @@ namespace Minisat {
         V*       begin  ()       { return &map[0]; }
         V*       end    ()       { return &map[map.size()]; }
 
-        void     reserve(K key, V pad)       { map.growTo(index(key)+1, pad); }
-        void     reserve(K key)              { map.growTo(index(key)+1); }
+        void     reserve(K key, V pad)       { int c = map.capacity(); map.growTo(index(key)+1, pad); if (map.capacity() != c) xadvise((V*)map, sizeof(V)*map.capacity()); }
+        void     reserve(K key)              { int c = map.capacity(); map.growTo(index(key)+1); if (map.capacity() != c) xadvise((V*)map, sizeof(V)*map.capacity()); }
         void     insert (K key, V val, V pad){ reserve(key, pad); operator[](key) = val; }
         void     insert (K key, V val)       { reserve(key); operator[](key) = val; }
 
@@ -0,0 +1,115 @@
+/*************************************************************************************[VmtfQueue.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_VmtfQueue_h
+#define Minisat_VmtfQueue_h
+
+#include "solver/mtl/IntTypes.h"
+#include "solver/mtl/IntMap.h"
+
+namespace Minisat {
+
+//=================================================================================================
+// A variable-move-to-front queue: a doubly linked list of keys ordered by the time they were last
+// moved to the front. Every move gets a fresh (strictly increasing) stamp, so the relative order
+// of two keys can be checked in constant time. The queue also caches a search position, which the
+// user maintains so that all keys more recent than it are known not to be eligible.
+
+
+template<class K, class MkIndex = MkIndexDefault<K> >
+class VmtfQueue {
+    struct Link {
+        K        prev, next;
+        uint64_t stamp;
+        bool     queued;
+    };
+
+    IntMap<K,Link,MkIndex> links;
+    K                      first_;   // Least recently moved key.
+    K                      last_;    // Most recently moved key.
+    K                      search_;  // Cached search position (see above).
+    uint64_t               stamps;
+    K                      none;     // Key used as 'null' link.
+
+    void unlink(K k)
+    {
+        Link& l = links[k];
+        if (l.prev != none) links[l.prev].next = l.next; else first_ = l.next;
+        if (l.next != none) links[l.next].prev = l.prev; else last_  = l.prev;
+    }
+
+    void append(K k)
+    {
+        Link& l = links[k];
+        l.prev  = last_;
+        l.next  = none;
+        l.stamp = ++stamps;
+        if (last_ != none) links[last_].next = k; else first_ = k;
+        last_ = k;
+    }
+
+  public:
+    explicit VmtfQueue(K _none, MkIndex _index = MkIndex()) : links(_index), first_(_none), last_(_none), search_(_none), stamps(0), none(_none) {}
+
+    bool     inQueue   (K k) const { return links.has(k) && links[k].queued; }
+    K        first     ()    const { return first_; }
+    K        last      ()    const { return last_; }
+    K        prev      (K k) const { return links[k].prev; }
+    K        next      (K k) const { return links[k].next; }
+    uint64_t stamp     (K k) const { return links[k].stamp; }
+
+    K        searchPos ()    const { return search_; }
+    void     setSearch (K k)       { search_ = k; }
+
+    // Make 'k' the search position if it is more recent than the current one:
+    void     updateSearch(K k)
+    {
+        assert(inQueue(k));
+        if (search_ == none || links[k].stamp > links[search_].stamp)
+            search_ = k;
+    }
+
+    // Add a new key as the most recent element:
+    void insert(K k)
+    {
+        Link pad = { none, none, 0, false };
+        links.reserve(k, pad);
+        assert(!inQueue(k));
+        links[k].queued = true;
+        append(k);
+    }
+
+    void moveToFront(K k)
+    {
+        assert(inQueue(k));
+        if (last_ == k) return;
+        unlink(k);
+        append(k);
+    }
+
+    void clear(bool dispose = false)
+    {
+        links.clear(dispose);
+        first_ = last_ = search_ = none;
+    }
+};
+
+
+//=================================================================================================
+}
+
+#endif
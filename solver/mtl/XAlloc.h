@@ -23,6 +23,14 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 
 #include <errno.h>
 #include <stdlib.h>
+#include <stdint.h>
+
+#if defined(__linux__)
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#endif
 
 namespace Minisat {
 
@@ -39,6 +47,105 @@ static inline void* xrealloc(void *ptr, size_t size)
         return mem;
 }
 
+//=================================================================================================
+// Process-wide policy for the backing memory of large arrays (set before creating solvers):
+
+struct MemoryPolicy
+{
+    bool mmap_arena;  // Back region allocators by reserved address space that is committed on demand.
+    bool huge_pages;  // Advise transparent huge pages for large arrays.
+    bool numa_bind;   // Bind large arrays to the NUMA node of the thread that grows them.
+};
+
+inline MemoryPolicy memory_policy = { true, true, false };
+
+static const size_t huge_page_size = 2 * 1024 * 1024;
+
+#if defined(__linux__)
+
+// Apply the memory policy to the pages within '[ptr, ptr+size)':
+static inline void xadvise(void* ptr, size_t size)
+{
+    if ((!memory_policy.huge_pages && !memory_policy.numa_bind) || size < huge_page_size)
+        return;
+
+    size_t    page = (size_t)sysconf(_SC_PAGESIZE);
+    uintptr_t beg  = ((uintptr_t)ptr + page - 1) & ~(uintptr_t)(page - 1);
+    uintptr_t end  = ((uintptr_t)ptr + size) & ~(uintptr_t)(page - 1);
+    if (beg >= end)
+        return;
+
+#ifdef MADV_HUGEPAGE
+    if (memory_policy.huge_pages)
+        madvise((void*)beg, end - beg, MADV_HUGEPAGE);
+#endif
+
+#if defined(SYS_mbind) && defined(SYS_getcpu)
+    if (memory_policy.numa_bind){
+        const int mpol_bind = 2; // MPOL_BIND from <linux/mempolicy.h>
+        unsigned cpu, node;
+        if (syscall(SYS_getcpu, &cpu, &node, NULL) == 0 && node < 8 * sizeof(unsigned long)){
+            unsigned long nodemask = 1UL << node;
+            syscall(SYS_mbind, (void*)beg, end - beg, mpol_bind, &nodemask, 8 * sizeof(unsigned long), 0);
+        }
+    }
+#endif
+}
+
+// Reserve (but do not commit) address space for up to 'max_size' bytes. Returns NULL if the
+// address space is limited or the reservation fails, in which case 'xrealloc' should be used:
+static inline void* xreserve(size_t max_size, size_t& reserved)
+{
+    rlimit rl;
+    if (!memory_policy.mmap_arena || (getrlimit(RLIMIT_AS, &rl) == 0 && rl.rlim_cur != RLIM_INFINITY))
+        return NULL;
+
+    long pages = sysconf(_SC_PHYS_PAGES);
+    size_t phys = pages > 0 ? (size_t)pages * (size_t)sysconf(_SC_PAGESIZE) : max_size;
+    size_t size = ((max_size < phys ? max_size : phys) + huge_page_size - 1) & ~(huge_page_size - 1);
+
+    // Over-reserve so that the region can start at a huge page boundary:
+    char* mem = (char*)mmap(NULL, size + huge_page_size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (mem == MAP_FAILED)
+        return NULL;
+
+    char* beg = (char*)(((uintptr_t)mem + huge_page_size - 1) & ~(uintptr_t)(huge_page_size - 1));
+    if (beg > mem)
+        munmap(mem, beg - mem);
+    if (beg + size < mem + size + huge_page_size)
+        munmap(beg + size, mem + size + huge_page_size - (beg + size));
+
+    reserved = size;
+    return beg;
+}
+
+// Commit the reserved bytes '[old_size, new_size)' of a region returned by 'xreserve':
+static inline void xcommit(void* mem, size_t old_size, size_t new_size, size_t reserved)
+{
+    size_t page = memory_policy.huge_pages ? huge_page_size : (size_t)sysconf(_SC_PAGESIZE);
+    old_size = (old_size + page - 1) & ~(page - 1);
+    new_size = (new_size + page - 1) & ~(page - 1);
+    if (new_size > reserved)
+        throw OutOfMemoryException();
+    if (new_size <= old_size)
+        return;
+
+    if (mprotect((char*)mem + old_size, new_size - old_size, PROT_READ | PROT_WRITE) != 0)
+        throw OutOfMemoryException();
+    xadvise((char*)mem + old_size, new_size - old_size);
+}
+
+static inline void xunreserve(void* mem, size_t reserved) { munmap(mem, reserved); }
+
+#else
+
+static inline void  xadvise   (void*, size_t) {}
+static inline void* xreserve  (size_t, size_t&) { return NULL; }
+static inline void  xcommit   (void*, size_t, size_t, size_t) { throw OutOfMemoryException(); }
+static inline void  xunreserve(void*, size_t) {}
+
+#endif
+
 //=================================================================================================
 }
 
@@ -0,0 +1,111 @@
+/******************************************************************************[ClauseExchange.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include "solver/parallel/ClauseExchange.h"
+
+using namespace Minisat;
+
+ClauseExchange::ClauseExchange(int log_capacity) :
+    capacity((uint64_t)1 << log_capacity),
+    slots(new Slot[(uint64_t)1 << log_capacity]),
+    head(0)
+{
+    for (uint64_t i = 0; i < capacity; i++)
+    {
+        slots[i].seq.store(0, std::memory_order_relaxed);
+    }
+}
+
+ClauseExchange::~ClauseExchange()
+{
+    delete[] slots;
+}
+
+void ClauseExchange::push(int producer, const vec<Lit> &lits)
+{
+    assert(lits.size() <= max_size);
+    uint64_t ticket = head.fetch_add(1, std::memory_order_relaxed);
+    Slot &s = slots[ticket & (capacity - 1)];
+
+    // Mark the slot as being written, but only once the ticket of the previous lap is complete, so
+    // that a stale writer never stores a sequence number below that of a newer clause (this waits
+    // only if that writer was preempted for a whole lap):
+    uint64_t ready = ticket >= capacity ? 2 * (ticket - capacity) + 2 : 0;
+    uint64_t seq = ready;
+    while (!s.seq.compare_exchange_weak(seq, ready | 1, std::memory_order_relaxed))
+    {
+        assert(seq <= ready); // Only this ticket may write the lap after 'ready'.
+        seq = ready;
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    s.producer.store(producer, std::memory_order_relaxed);
+    s.size.store(lits.size(), std::memory_order_relaxed);
+    for (int i = 0; i < lits.size(); i++)
+    {
+        s.lits[i].store(toInt(lits[i]), std::memory_order_relaxed);
+    }
+
+    s.seq.store(2 * ticket + 2, std::memory_order_release);
+}
+
+bool ClauseExchange::pull(int consumer, uint64_t &cursor, vec<Lit> &out)
+{
+    for (;;)
+    {
+        uint64_t end = head.load(std::memory_order_acquire);
+        if (cursor >= end)
+        {
+            return false;
+        }
+        else if (end - cursor > capacity)
+        {
+            cursor = end - capacity;
+        }
+
+        Slot &s = slots[cursor & (capacity - 1)];
+        uint64_t expected = 2 * cursor + 2;
+        uint64_t seq = s.seq.load(std::memory_order_acquire);
+        if (seq < expected || (seq & 1))
+        {
+            return false; // Not written yet (or being overwritten, then it is skipped later).
+        }
+        else if (seq > expected)
+        {
+            cursor++; // Overwritten.
+            continue;
+        }
+
+        int producer = s.producer.load(std::memory_order_relaxed);
+        int size = s.size.load(std::memory_order_relaxed);
+        out.clear();
+        for (int i = 0; i < size && i < max_size; i++)
+        {
+            out.push(toLit(s.lits[i].load(std::memory_order_relaxed)));
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        bool torn = s.seq.load(std::memory_order_relaxed) != seq;
+
+        cursor++;
+        if (!torn && producer != consumer)
+        {
+            return true;
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*******************************************************************************[ClauseExchange.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_ClauseExchange_h
+#define Minisat_ClauseExchange_h
+
+#include <atomic>
+
+#include "solver/mtl/Vec.h"
+#include "solver/core/SolverTypes.h"
+
+namespace Minisat
+{
+
+    //=================================================================================================
+    // ClauseExchange -- a ring buffer of short clauses, written by many threads and read by all of
+    // them:
+    //
+    // A writer takes the next ticket from 'head' and owns slot 'ticket % capacity' while it copies
+    // the clause in. The sequence number of a slot is odd while it is written, and '2*ticket+2' once
+    // the clause of 'ticket' is complete. Each reader keeps its own cursor (the next ticket to read)
+    // and validates a slot before and after copying it out, like a sequence lock, so a clause that is
+    // overwritten meanwhile is skipped. A reader that falls more than 'capacity' tickets behind
+    // loses the oldest clauses. Readers never wait.
+    //
+    // Writers are not lock-free on lap wrap-around: a writer waits until the ticket one lap earlier
+    // is complete, so the sequence number of a slot never decreases. It only waits if 'capacity'
+    // clauses were pushed while that writer copied its own, i.e. if that writer was preempted. (Not
+    // writing the clause instead would leave the slot behind its ticket, and the readers would stop
+    // there until they fall a lap behind.)
+
+    class ClauseExchange
+    {
+    public:
+        static const int max_size = 8; // The longest clause that can be exchanged.
+
+        explicit ClauseExchange(int log_capacity = 14);
+        ~ClauseExchange();
+
+        void push(int producer, const vec<Lit> &lits); // Requires 'lits.size() <= max_size'.
+
+        // Copies the next clause of another producer than 'consumer' into 'out' and advances the
+        // cursor past it. Returns FALSE if there is none yet:
+        bool pull(int consumer, uint64_t &cursor, vec<Lit> &out);
+
+        bool pending(uint64_t cursor) const { return cursor < head.load(std::memory_order_acquire); }
+
+    protected:
+        struct Slot
+        {
+            std::atomic<uint64_t> seq;
+            std::atomic<int> producer;
+            std::atomic<int> size;
+            std::atomic<uint32_t> lits[max_size];
+        };
+
+        uint64_t capacity;
+        Slot *slots;
+        std::atomic<uint64_t> head; // The next ticket.
+    };
+
+    //=================================================================================================
+}
+
+#endif
@@ -0,0 +1,246 @@
+/******************************************************************************[CubeAndConquer.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <thread>
+
+#include "solver/mtl/Sort.h"
+#include "solver/parallel/CubeAndConquer.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Constructor:
+
+CubeAndConquer::CubeAndConquer(Solver &_master, const Loader &_load, int threads) :
+    cubes(0),
+    refuted_cubes(0),
+    pruned_cubes(0),
+    conflicts(0),
+    decisions(0),
+    propagations(0),
+    shared_exported(0),
+    shared_imported(0),
+    shared_useful(0),
+    master(_master),
+    load(_load),
+    n_threads(threads),
+    queues(threads),
+    owned(threads),
+    solvers(threads),
+    done(false),
+    result(l_Undef)
+{
+    for (int t = 0; t < n_threads; t++)
+    {
+        solvers[t] = NULL;
+    }
+
+    if (n_threads > 1)
+    {
+        exchange.reset(new ClauseExchange());
+    }
+}
+
+//=================================================================================================
+// Solving:
+
+lbool CubeAndConquer::solve(int max_cubes)
+{
+    if (!master.lookaheadCubes(max_cubes, cube_lits))
+    {
+        return l_False;
+    }
+
+    cubes = cube_lits.size();
+    for (int i = 0; i < cube_lits.size(); i++)
+    {
+        sort(cube_lits[i]);
+        queues[i % n_threads].cubes.push_back(i);
+    }
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; t++)
+    {
+        threads.emplace_back(&CubeAndConquer::work, this, t);
+    }
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        threads[t].join();
+    }
+
+    // Every cube was refuted or pruned unless some thread finished early:
+    return done ? result : l_False;
+}
+
+void CubeAndConquer::interrupt()
+{
+    done = true;
+    for (int t = 0; t < n_threads; t++)
+    {
+        Solver *S = solvers[t];
+        if (S != NULL)
+        {
+            S->interrupt();
+        }
+    }
+}
+
+void CubeAndConquer::finish(lbool status, Solver &S)
+{
+    std::lock_guard<std::mutex> guard(result_lock);
+    if (done)
+    {
+        return;
+    }
+
+    result = status;
+    if (status == l_True)
+    {
+        S.model.copyTo(model);
+    }
+
+    interrupt();
+}
+
+void CubeAndConquer::work(int thread)
+{
+    // The workers run with the configuration of the master:
+    SolverConfig config = master;
+    config.verbosity = 0;
+    owned[thread].reset(new Solver(config));
+    Solver &S = *owned[thread];
+    S.exchange = exchange.get();
+    S.exchange_id = thread;
+    load(S);
+
+    // The cube literals are assumptions, so their variables must stay in the clauses:
+    for (int i = 0; i < cube_lits.size(); i++)
+    {
+        for (int j = 0; j < cube_lits[i].size(); j++)
+        {
+            S.setFrozen(var(cube_lits[i][j]), true);
+        }
+    }
+
+    solvers[thread] = &S;
+
+    vec<Lit> core;
+    for (int c; !done && (c = takeCube(thread)) >= 0;)
+    {
+        const vec<Lit> &cube = cube_lits[c];
+        if (covered(cube))
+        {
+            std::lock_guard<std::mutex> guard(core_lock);
+            pruned_cubes++;
+            continue;
+        }
+
+        lbool status = S.solveLimited(cube);
+        if (status != l_False)
+        {
+            finish(status, S);
+            break;
+        }
+
+        // The final conflict holds the negations of the assumptions used to refute the cube:
+        core.clear();
+        for (int i = 0; i < cube.size(); i++)
+        {
+            if (S.conflict.has(~cube[i]))
+            {
+                core.push(cube[i]);
+            }
+        }
+
+        if (core.size() == 0)
+        {
+            finish(l_False, S);
+            break;
+        }
+
+        std::lock_guard<std::mutex> guard(core_lock);
+        refuted_cubes++;
+        cores.push();
+        core.copyTo(cores.last());
+    }
+
+    std::lock_guard<std::mutex> guard(result_lock);
+    conflicts += S.conflicts;
+    decisions += S.decisions;
+    propagations += S.propagations;
+    shared_exported += S.shared_exported;
+    shared_imported += S.shared_imported;
+    shared_useful += S.shared_useful;
+}
+
+int CubeAndConquer::takeCube(int thread)
+{
+    for (int k = 0; k < n_threads; k++)
+    {
+        WorkQueue &q = queues[(thread + k) % n_threads];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.cubes.empty())
+        {
+            continue;
+        }
+
+        // The own queue from the front, the others (stealing) from the back:
+        int c;
+        if (k == 0)
+        {
+            c = q.cubes.front();
+            q.cubes.pop_front();
+        }
+        else
+        {
+            c = q.cubes.back();
+            q.cubes.pop_back();
+        }
+
+        return c;
+    }
+
+    return -1;
+}
+
+bool CubeAndConquer::covered(const vec<Lit> &cube)
+{
+    std::lock_guard<std::mutex> guard(core_lock);
+    for (int i = 0; i < cores.size(); i++)
+    {
+        const vec<Lit> &core = cores[i];
+        if (core.size() > cube.size())
+        {
+            continue;
+        }
+
+        // Both are sorted:
+        int j = 0;
+        for (int k = 0; j < core.size() && k < cube.size(); k++)
+        {
+            j += cube[k] == core[j];
+        }
+
+        if (j == core.size())
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
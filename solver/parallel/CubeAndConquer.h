@@ -0,0 +1,95 @@
+/*******************************************************************************[CubeAndConquer.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_CubeAndConquer_h
+#define Minisat_CubeAndConquer_h
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "solver/mtl/Vec.h"
+#include "solver/core/Solver.h"
+#include "solver/parallel/ClauseExchange.h"
+
+namespace Minisat
+{
+
+    //=================================================================================================
+    // CubeAndConquer -- split a problem by lookahead and solve the cubes on parallel threads:
+    //
+    // The cubes are dealt round-robin to per-thread queues. A thread takes cubes from the front of
+    // its own queue and, when that is empty, steals from the back of the others. Each thread owns a
+    // solver, loaded by 'load', that keeps its learnt clauses from cube to cube. A refuted cube
+    // leaves the subset of its literals that were used (the final conflict); pending cubes that
+    // contain such a core are pruned without solving. The first satisfiable cube interrupts all
+    // threads. With more than one thread, the solvers share their short learnt clauses, which hold
+    // regardless of the cube.
+
+    class CubeAndConquer
+    {
+    public:
+        typedef std::function<void(Solver &)> Loader; // Adds the problem to an empty solver.
+
+        CubeAndConquer(Solver &master, const Loader &load, int threads);
+
+        lbool solve(int max_cubes); // Returns 'l_Undef' if interrupted or out of budget.
+        void interrupt(); // Safe in a signal handler.
+
+        vec<lbool> model; // If the problem is satisfiable, the model of the winning cube.
+
+        // Statistics: (read-only member variable)
+        //
+        int cubes, refuted_cubes, pruned_cubes;
+        uint64_t conflicts, decisions, propagations; // Summed over the threads.
+        uint64_t shared_exported, shared_imported, shared_useful;
+
+    protected:
+        struct WorkQueue
+        {
+            std::mutex lock;
+            std::deque<int> cubes;
+        };
+
+        Solver &master;
+        Loader load;
+        int n_threads;
+
+        vec<vec<Lit> > cube_lits;
+        std::deque<WorkQueue> queues;
+        std::mutex core_lock;
+        vec<vec<Lit> > cores; // Refuted subsets of the cubes (sorted).
+        std::mutex result_lock;
+        std::vector<std::unique_ptr<Solver> > owned; // The solver of each thread.
+        std::deque<std::atomic<Solver *> > solvers;  // Published when ready to be interrupted.
+        std::unique_ptr<ClauseExchange> exchange;    // Learnt clauses shared by the threads (NULL if only one).
+        std::atomic<bool> done;
+        lbool result;
+
+        void work(int thread);
+        int takeCube(int thread);       // Returns -1 if all queues are empty.
+        bool covered(const vec<Lit> &cube); // Does a refuted core cover the (sorted) cube?
+        void finish(lbool status, Solver &S);
+    };
+
+    //=================================================================================================
+}
+
+#endif
@@ -0,0 +1,201 @@
+/***********************************************************************************[Portfolio.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <math.h>
+#include <thread>
+
+#include "solver/parallel/Portfolio.h"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Configurations:
+
+static void configDefault(SolverConfig &) {}
+
+static void configVmtf(SolverConfig &C)
+{
+    C.branching = branch_order;
+    C.decision_order = 1;
+}
+
+static void configTargetPhase(SolverConfig &C)
+{
+    C.target_phase = true;
+    C.rephase_int = 1000;
+}
+
+static void configInprocess(SolverConfig &C)
+{
+    C.inprocess_int = 2000;
+}
+
+static void configPodem(SolverConfig &C)
+{
+    C.podem = true;
+}
+
+static void configGeometric(SolverConfig &C)
+{
+    C.luby_restart = false;
+    C.restart_first = 100;
+    C.restart_inc = 1.5;
+}
+
+static void configChrono(SolverConfig &C)
+{
+    C.chrono = 100;
+    C.reuse_trail = true;
+}
+
+static void configLocalSearch(SolverConfig &C)
+{
+    C.ls_int = 2000;
+}
+
+static void configRandom(SolverConfig &C)
+{
+    C.branching = branch_order;
+    C.random_var_freq = 0.02;
+    C.rnd_init_act = true;
+}
+
+static void configJFrontierActivity(SolverConfig &C)
+{
+    C.branching = branch_jfrontier_activity;
+}
+
+static void configAvoidXor(SolverConfig &C)
+{
+    C.bp_activity = true;
+    C.bp_xor = xor_avoid;
+}
+
+static void configCircuitStart(SolverConfig &C)
+{
+    C.csat_start = 1;
+    C.polarity_init = polarity_max_prob;
+}
+
+static const Portfolio::Config configs[] = {
+    {"default", configDefault},
+    {"vmtf", configVmtf},
+    {"target-phase", configTargetPhase},
+    {"inprocess", configInprocess},
+    {"podem", configPodem},
+    {"geometric", configGeometric},
+    {"chrono", configChrono},
+    {"local-search", configLocalSearch},
+    {"random", configRandom},
+    {"jfrontier-activity", configJFrontierActivity},
+    {"avoid-xor", configAvoidXor},
+    {"circuit-start", configCircuitStart},
+};
+
+static const int n_configs = sizeof(configs) / sizeof(configs[0]);
+
+//=================================================================================================
+// Constructor:
+
+Portfolio::Portfolio(const Loader &_load, int threads) :
+    winner(-1),
+    load(_load),
+    n_threads(threads),
+    owned(threads),
+    solvers(threads),
+    done(false),
+    result(l_Undef)
+{
+    for (int t = 0; t < n_threads; t++)
+    {
+        solvers[t] = NULL;
+    }
+}
+
+const char *Portfolio::configName(int thread) const
+{
+    return configs[thread % n_configs].name;
+}
+
+//=================================================================================================
+// Solving:
+
+lbool Portfolio::solve()
+{
+    std::vector<std::thread> threads;
+    for (int t = 0; t < n_threads; t++)
+    {
+        threads.emplace_back(&Portfolio::work, this, t);
+    }
+
+    for (int t = 0; t < n_threads; t++)
+    {
+        threads[t].join();
+    }
+
+    return result;
+}
+
+void Portfolio::interrupt()
+{
+    done = true;
+    for (int t = 0; t < n_threads; t++)
+    {
+        Solver *S = solvers[t];
+        if (S != NULL)
+        {
+            S->interrupt();
+        }
+    }
+}
+
+void Portfolio::work(int thread)
+{
+    SolverConfig config;
+    config.verbosity = 0;
+    configs[thread % n_configs].apply(config);
+    if (thread > 0)
+    {
+        // Any positive seed below the modulus of the generator:
+        config.random_seed = 1 + fmod(config.random_seed + 104729.0 * thread, 2147483646.0);
+    }
+
+    owned[thread].reset(new Solver(config));
+    Solver &S = *owned[thread];
+    S.exchange = &exchange;
+    S.exchange_id = thread;
+
+    load(S);
+    solvers[thread] = &S;
+
+    lbool status = done ? l_Undef : S.simplify() ? S.solveLimited(vec<Lit>()) : l_False;
+
+    std::lock_guard<std::mutex> guard(result_lock);
+    if (done || status == l_Undef)
+    {
+        return;
+    }
+
+    result = status;
+    winner = thread;
+    if (status == l_True)
+    {
+        S.model.copyTo(model);
+    }
+
+    interrupt();
+}
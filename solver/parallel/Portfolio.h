@@ -0,0 +1,82 @@
+/************************************************************************************[Portfolio.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Portfolio_h
+#define Minisat_Portfolio_h
+
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "solver/mtl/Vec.h"
+#include "solver/core/Solver.h"
+#include "solver/parallel/ClauseExchange.h"
+
+namespace Minisat
+{
+
+    //=================================================================================================
+    // Portfolio -- run differently configured solvers on the same problem in parallel threads:
+    //
+    // Thread 'i' runs configuration 'i' modulo the number of configurations, with its own random
+    // seed. A configuration changes the parameters taken from the command-line options before the
+    // solver is created (the first one keeps them). The solvers share their short learnt clauses. The
+    // first thread to finish wins and interrupts the others.
+
+    class Portfolio
+    {
+    public:
+        typedef std::function<void(Solver &)> Loader; // Adds the problem to an empty solver.
+
+        struct Config
+        {
+            const char *name;
+            void (*apply)(SolverConfig &);
+        };
+
+        Portfolio(const Loader &load, int threads);
+
+        lbool solve(); // Returns 'l_Undef' if interrupted or out of budget.
+        void interrupt(); // Safe in a signal handler.
+
+        vec<lbool> model; // If the problem is satisfiable, the model of the winner.
+        int winner;       // The thread that finished first (-1 if none).
+
+        const char *configName(int thread) const;
+        const Solver &solver(int thread) const { return *owned[thread]; }
+
+    protected:
+        Loader load;
+        int n_threads;
+
+        std::mutex result_lock;
+        std::vector<std::unique_ptr<Solver> > owned; // The solver of each thread.
+        std::deque<std::atomic<Solver *> > solvers;  // Published when ready to be interrupted.
+        ClauseExchange exchange;                     // Learnt clauses shared by the threads.
+        std::atomic<bool> done;
+        lbool result;
+
+        void work(int thread);
+    };
+
+    //=================================================================================================
+}
+
+#endif
@@ -0,0 +1,160 @@
+/***********************************************************************************[StressTest.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <fstream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "solver/utils/Options.h"
+#include "solver/utils/System.h"
+#include "solver/core/Dimacs.h"
+#include "solver/core/Solver.h"
+
+#include "core/source/structures/parser.hpp"
+#include "core/source/bench_to_cnf/bench_to_cnf.hpp"
+
+using namespace Minisat;
+
+//=================================================================================================
+// Stress test of independent solvers -- solves an instance once, then with the same configuration
+// in 'threads' solvers at the same time, and checks that every parallel run has the result and the
+// conflict, decision and propagation counts of the serial one. Solvers configured per instance
+// share no state, so any difference is a data race (or a decision taken on the shared clock). With
+// a conflict budget the runs stop early, the counts must still agree.
+
+struct Run
+{
+    lbool result;
+    uint64_t conflicts;
+    uint64_t decisions;
+    uint64_t propagations;
+    bool verified;
+};
+
+static Run solveOnce(const SolverConfig &config, const std::shared_ptr<csat::DAG> &circuit, const char *cnf_file_name, int conflicts)
+{
+    Solver S(config);
+    S.csat_instance = circuit;
+    gzFile in = gzopen(cnf_file_name, "rb");
+    parse_DIMACS(in, S);
+    gzclose(in);
+
+    vec<Lit> dummy;
+    if (conflicts > 0)
+    {
+        S.setConfBudget(conflicts);
+    }
+
+    Run r;
+    r.result = S.simplify() ? S.solveLimited(dummy) : l_False;
+    r.conflicts = S.conflicts;
+    r.decisions = S.decisions;
+    r.propagations = S.propagations;
+    r.verified = r.result != l_True || S.verifySolution();
+    return r;
+}
+
+static const char *resultName(lbool result)
+{
+    return result == l_True ? "SATISFIABLE" : result == l_False ? "UNSATISFIABLE" : "INDETERMINATE";
+}
+
+static bool report(const char *name, const Run &r, const Run *serial)
+{
+    bool same = serial == NULL || (r.result == serial->result && r.conflicts == serial->conflicts &&
+                                   r.decisions == serial->decisions && r.propagations == serial->propagations);
+    printf("%-10s : %-14s %12" PRIu64 " conflicts %12" PRIu64 " decisions %14" PRIu64 " propagations%s%s\n",
+           name, resultName(r.result), r.conflicts, r.decisions, r.propagations,
+           r.verified ? "" : "  <- WRONG MODEL", same ? "" : "  <- DIFFERS");
+    return same && r.verified;
+}
+
+int main(int argc, char **argv)
+{
+    setUsageHelp("USAGE: %s [options] <input-file>\n\n  where input is BENCH file.\n");
+
+    IntOption threads("TEST", "threads", "Number of solvers run in parallel.", 4, IntRange(1, 1024));
+    IntOption conflicts("TEST", "conflicts", "Conflict budget of each run (0=none).", 3000, IntRange(0, INT32_MAX));
+
+    parseOptions(argc, argv, true);
+
+    if (argc < 2)
+    {
+        printf("ERROR! Not enough arguments\n"), exit(1);
+    }
+
+    std::ifstream file(argv[1]);
+    if (!file.is_open())
+    {
+        printf("ERROR! Could not open file: %s\n", argv[1]), exit(1);
+    }
+
+    auto parser = csat::BenchParser<csat::DAG>();
+    parser.parseStream(file);
+    file.clear();
+    file.seekg(0);
+    std::shared_ptr<csat::DAG> circuit = parser.instantiate();
+
+    auto bench_to_cnf_parser = bench_to_cnf::BenchToCNFParser();
+    bench_to_cnf_parser.parseStream(file);
+    file.close();
+
+    char cnf_file_name[] = "/tmp/stress-test-XXXXXX";
+    int fd = mkstemp(cnf_file_name);
+    if (fd < 0)
+    {
+        printf("ERROR! Could not create a temporary file\n"), exit(1);
+    }
+
+    close(fd);
+    std::ofstream cnf_file(cnf_file_name);
+    bench_to_cnf_parser.writeCNFToStream(cnf_file);
+    cnf_file.close();
+
+    SolverConfig config;
+    Run serial = solveOnce(config, circuit, cnf_file_name, conflicts);
+
+    std::vector<Run> parallel(threads);
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threads; i++)
+    {
+        workers.emplace_back([&, i]() { parallel[i] = solveOnce(config, circuit, cnf_file_name, conflicts); });
+    }
+
+    for (int i = 0; i < threads; i++)
+    {
+        workers[i].join();
+    }
+
+    unlink(cnf_file_name);
+
+    bool ok = report("serial", serial, NULL);
+    for (int i = 0; i < threads; i++)
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "thread %d", i);
+        ok &= report(name, parallel[i], &serial);
+    }
+
+    printf(ok ? "OK\n" : "FAILED\n");
+    return ok ? 0 : 1;
+}
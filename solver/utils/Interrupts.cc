@@ -0,0 +1,74 @@
+/***********************************************************************************[Interrupts.cc]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#include <thread>
+
+#include "solver/utils/Interrupts.h"
+
+using namespace Minisat;
+
+InterruptRegistry::InterruptRegistry() : broadcasts(0)
+{
+    for (int i = 0; i < max_entries; i++)
+    {
+        entries[i].state = 0;
+    }
+}
+
+int InterruptRegistry::add(void *target, void (*interrupt)(void *))
+{
+    for (int i = 0; i < max_entries; i++)
+    {
+        int free = 0;
+        if (entries[i].state.compare_exchange_strong(free, 1))
+        {
+            entries[i].target = target;
+            entries[i].interrupt = interrupt;
+            entries[i].state = 2;
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+void InterruptRegistry::remove(int slot)
+{
+    entries[slot].state = 1;
+
+    // A broadcast that saw the entry before may still be using it:
+    while (broadcasts > 0)
+    {
+        std::this_thread::yield();
+    }
+
+    entries[slot].state = 0;
+}
+
+void InterruptRegistry::broadcast()
+{
+    broadcasts++;
+    for (int i = 0; i < max_entries; i++)
+    {
+        if (entries[i].state == 2)
+        {
+            entries[i].interrupt(entries[i].target);
+        }
+    }
+
+    broadcasts--;
+}
@@ -0,0 +1,84 @@
+/************************************************************************************[Interrupts.h]
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT
+NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT
+OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+**************************************************************************************************/
+
+#ifndef Minisat_Interrupts_h
+#define Minisat_Interrupts_h
+
+#include <atomic>
+
+namespace Minisat {
+
+//=================================================================================================
+// InterruptRegistry -- the objects that a termination signal interrupts:
+//
+// Any object with an 'interrupt()' method (a solver, a portfolio, ...) can be registered, from any
+// thread. 'broadcast()' neither locks nor allocates, so it can be called from a signal handler.
+// 'remove()' waits for a broadcast in progress, after which the object may be destroyed.
+
+class InterruptRegistry
+{
+public:
+    static const int max_entries = 64;
+
+    InterruptRegistry();
+
+    template <class T>
+    int add(T &target) // Returns the slot of 'target' (-1 if all are taken).
+    {
+        return add(&target, [](void *t) { static_cast<T *>(t)->interrupt(); });
+    }
+
+    void remove(int slot);
+    void broadcast();
+
+protected:
+    struct Entry
+    {
+        std::atomic<int> state; // 0: free, 1: taken, 2: ready to be interrupted.
+        void *target;
+        void (*interrupt)(void *);
+    };
+
+    Entry entries[max_entries];
+    std::atomic<int> broadcasts; // The broadcasts in progress.
+
+    int add(void *target, void (*interrupt)(void *));
+};
+
+//=================================================================================================
+// InterruptScope -- keeps an object registered while in scope:
+
+class InterruptScope
+{
+public:
+    template <class T>
+    InterruptScope(InterruptRegistry &_registry, T &target) : registry(_registry), slot(_registry.add(target)) {}
+    ~InterruptScope() { if (slot >= 0) registry.remove(slot); }
+
+private:
+    InterruptRegistry &registry;
+    int slot;
+
+    // Don't allow copying (the slot would be removed twice):
+    InterruptScope(const InterruptScope &);
+    InterruptScope &operator=(const InterruptScope &);
+};
+
+//=================================================================================================
+}
+
+#endif
@@ -159,6 +159,44 @@ void Minisat::limitTime(uint32_t /*max_cpu_time*/)
 #endif
 
 
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <string.h>
+
+int Minisat::openCacheMissCounter()
+{
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.size           = sizeof(attr);
+    attr.config         = PERF_COUNT_HW_CACHE_MISSES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv     = 1;
+
+    return (int)syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+uint64_t Minisat::readCacheMissCounter(int handle)
+{
+    uint64_t count;
+    if (handle < 0 || read(handle, &count, sizeof(count)) != sizeof(count))
+        return 0;
+    return count;
+}
+
+void Minisat::closeCacheMissCounter(int handle)
+{
+    if (handle >= 0)
+        close(handle);
+}
+#else
+int      Minisat::openCacheMissCounter()           { return -1; }
+uint64_t Minisat::readCacheMissCounter(int)        { return 0; }
+void     Minisat::closeCacheMissCounter(int)       { }
+#endif
+
+
 void Minisat::sigTerm(void handler(int))
 {
     signal(SIGINT, handler);
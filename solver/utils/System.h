@@ -32,6 +32,7 @@ OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWA
 namespace Minisat {
 
 static inline double cpuTime(void); // CPU-time in seconds.
+static inline double threadCpuTime(void); // CPU-time of the calling thread in seconds.
 
 extern double memUsed();            // Memory in mega bytes (returns 0 for unsupported architectures).
 extern double memUsedPeak(bool strictlyPeak = false); // Peak-memory in mega bytes (returns 0 for unsupported architectures).
@@ -47,6 +48,11 @@ extern void   limitTime(uint32_t max_cpu_time); // Set a limit on maximum CPU ti
 
 extern void   sigTerm(void handler(int));      // Set up handling of available termination signals.
 
+extern int    openCacheMissCounter();          // Start counting the hardware cache misses of the calling
+                                               // thread. Returns a handle, or -1 if not supported.
+extern uint64_t readCacheMissCounter(int handle); // Cache misses counted so far (0 for handle -1).
+extern void   closeCacheMissCounter(int handle);
+
 }
 
 //-------------------------------------------------------------------------------------------------
@@ -56,6 +62,7 @@ extern void   sigTerm(void handler(int));      // Set up handling of available t
 #include <time.h>
 
 static inline double Minisat::cpuTime(void) { return (double)clock() / CLOCKS_PER_SEC; }
+static inline double Minisat::threadCpuTime(void) { return cpuTime(); }
 
 #else
 #include <sys/time.h>
@@ -67,6 +74,16 @@ static inline double Minisat::cpuTime(void) {
     getrusage(RUSAGE_SELF, &ru);
     return (double)ru.ru_utime.tv_sec + (double)ru.ru_utime.tv_usec / 1000000; }
 
+#include <time.h>
+
+static inline double Minisat::threadCpuTime(void) {
+#ifdef CLOCK_THREAD_CPUTIME_ID
+    struct timespec ts;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) == 0)
+        return (double)ts.tv_sec + (double)ts.tv_nsec / 1000000000;
+#endif
+    return cpuTime(); }
+
 #endif
 
 #endif